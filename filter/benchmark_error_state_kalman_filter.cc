@@ -0,0 +1,53 @@
+// Measures the latency of the error-state Kalman filter's predict and update
+// steps on SO2, e.g. as run at IMU rate.
+
+#include <Eigen/Dense>
+#include <cstdio>
+
+#include "filter/error_state_kalman_filter.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr size_t kIterations = 1000000;
+
+using Vector1d = SO2GroupElement::TangentVector;
+using Matrix1d = SO2GroupElement::Jacobian;
+
+void Run() {
+  ErrorStateKalmanFilter<SO2GroupElement> filter(SO2GroupElement(0.0),
+                                                 Matrix1d(0.01));
+  std::printf("SO2 error-state Kalman filter, latency per step\n");
+
+  const double predict = MeasureNanoseconds(
+      [&] { filter.Predict(Vector1d(1e-3), Matrix1d(1e-6)); }, kIterations);
+  PrintBenchmark("Predict", predict, predict);
+
+  const SO2GroupElement observation(0.3);
+  const double update = MeasureNanoseconds(
+      [&] { filter.Update(observation, Matrix1d(1e-2)); }, kIterations);
+  PrintBenchmark("Update (observation)", update, predict);
+
+  const double update_bearing = MeasureNanoseconds(
+      [&] {
+        const Eigen::Matrix2d rotation = filter.state().AsMatrix();
+        const Eigen::Vector2d residual =
+            Eigen::Vector2d(0.0, 1.0) - rotation.col(0);
+        const Eigen::Matrix<double, 2, 1> jacobian = rotation.col(1);
+        filter.Update<2>(residual, jacobian,
+                         1e-2 * Eigen::Matrix2d::Identity());
+      },
+      kIterations);
+  PrintBenchmark("Update<2> (bearing)", update_bearing, predict);
+  DoNotOptimize(filter.covariance());
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
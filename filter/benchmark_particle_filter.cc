@@ -0,0 +1,72 @@
+// Measures the throughput, in particles per second, of a full particle filter
+// step (predict, update, and resample) on an SO2 heading tracker.
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "filter/particle_filter.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr size_t kNumParticles = 1 << 18;
+constexpr size_t kIterations = 50;
+
+template <typename Policy>
+double BenchmarkStep(const Policy& policy) {
+  using Vector1d = SO2GroupElement::TangentVector;
+  ParticleFilter<SO2GroupElement, Policy> filter(
+      ManifoldArray<SO2GroupElement>(kNumParticles, SO2GroupElement(0.0)),
+      /*seed=*/1, policy);
+  filter.Predict(Vector1d(0.0), SO2GroupElement::Jacobian(3.0));
+
+  int step = 0;
+  const double nanoseconds = MeasureNanoseconds(
+      [&] {
+        ++step;
+        filter.Predict(Vector1d(0.01), SO2GroupElement::Jacobian(0.05));
+        // Von Mises heading measurement, evaluated over storage columns.
+        const double heading = 0.01 * step;
+        const double cos_z = std::cos(heading);
+        const double sin_z = std::sin(heading);
+        filter.Update([&](const ManifoldArray<SO2GroupElement>& particles,
+                          size_t begin, size_t end, double* log_likelihoods) {
+          const auto chunk =
+              particles.storage().middleCols(begin, end - begin);
+          Eigen::Map<Eigen::RowVectorXd>(log_likelihoods + begin,
+                                         end - begin) =
+              25.0 * (cos_z * chunk.row(0) + sin_z * chunk.row(1));
+        });
+        filter.Resample();
+      },
+      kIterations);
+  DoNotOptimize(filter.particles().storage().data());
+  return nanoseconds / kNumParticles;
+}
+
+void Run() {
+  const size_t num_threads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  std::printf("SO2 particle filter step, %zu particles\n", kNumParticles);
+  const double sequential = BenchmarkStep(SequentialExecution());
+  PrintBenchmark("SequentialExecution", sequential, sequential);
+  const double parallel = BenchmarkStep(ParallelExecution());
+  PrintBenchmark("ParallelExecution", parallel, sequential);
+  std::printf("%-40s %10.3g particles/s\n", "SequentialExecution",
+              1e9 / sequential);
+  std::printf("%-40s %10.3g particles/s (%zu threads)\n",
+              "ParallelExecution", 1e9 / parallel, num_threads);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
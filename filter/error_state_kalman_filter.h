@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <utility>
+
+namespace mana {
+
+// An error-state extended Kalman filter over a Lie group. The estimate is a
+// group element X with a Gaussian error in its tangent space, defined on the
+// right (i.e. in the body frame):
+//   X_true = X.Rplus(dx), dx ~ N(0, P).
+// This is the left-invariant error of the invariant EKF, so for group-affine
+// motion models its propagation does not depend on the estimate.
+//
+// All matrices have fixed sizes, derived at compile time from the group's
+// `Dimension` and the measurement's dimension, so predict and update steps
+// never allocate.
+template <typename Group>
+class ErrorStateKalmanFilter {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Jacobian = typename Group::Jacobian;
+  using Covariance = Jacobian;
+  static constexpr int Dimension = Group::Dimension;
+
+  // Fixed-size types of a measurement of dimension `M`.
+  template <int M>
+  using MeasurementVector = Eigen::Matrix<Scalar, M, 1>;
+  template <int M>
+  using MeasurementJacobian = Eigen::Matrix<Scalar, M, Dimension>;
+  template <int M>
+  using MeasurementCovariance = Eigen::Matrix<Scalar, M, M>;
+
+  // Construct from an initial estimate and its error covariance.
+  ErrorStateKalmanFilter(Group state, const Covariance& covariance);
+
+  // Propagate the estimate by a motion increment, expressed in the body frame
+  // (e.g. integrated odometry or gyroscope readings), with covariance Q:
+  //   X <- X.Rplus(u),
+  //   P <- Ad(Exp(u))^{-1} P Ad(Exp(u))^{-T} + Jr(u) Q Jr(u)^T.
+  void Predict(const TangentVector& increment,
+               const Covariance& increment_covariance);
+
+  // Correct the estimate with a measurement z = h(X_true) + v, v ~ N(0, R),
+  // given its residual z - h(X) and Jacobian H = dh/d(dx) at the estimate.
+  // The covariance is updated in Joseph form, and then transported to the
+  // tangent space of the corrected estimate.
+  //
+  // Returns false, leaving the filter unchanged, if the innovation covariance
+  // H P H^T + R is not positive definite.
+  template <int M>
+  bool Update(const MeasurementVector<M>& residual,
+              const MeasurementJacobian<M>& jacobian,
+              const MeasurementCovariance<M>& noise_covariance);
+
+  // Correct the estimate with a direct, noisy observation of the state,
+  //   Z = X_true.Rplus(v), v ~ N(0, R).
+  // The residual is X.Rminus(Z), whose noise is Jr^{-1}(residual) v.
+  bool Update(const Group& observation, const Covariance& noise_covariance);
+
+  // Return the current estimate and its error covariance.
+  const Group& state() const;
+  const Covariance& covariance() const;
+
+ private:
+  Group state_;
+  Covariance covariance_;
+};
+
+template <typename Group>
+ErrorStateKalmanFilter<Group>::ErrorStateKalmanFilter(
+    Group state, const Covariance& covariance)
+    : state_(std::move(state)), covariance_(covariance) {}
+
+template <typename Group>
+void ErrorStateKalmanFilter<Group>::Predict(
+    const TangentVector& increment, const Covariance& increment_covariance) {
+  const Group motion = Group::Exp(increment);
+  const Jacobian transition = motion.Inverse().Adjoint();
+  const Jacobian noise_jacobian = Group::RightJacobian(increment);
+  state_ = state_.Compose(motion);
+  covariance_ = transition * covariance_ * transition.transpose() +
+                noise_jacobian * increment_covariance *
+                    noise_jacobian.transpose();
+}
+
+template <typename Group>
+template <int M>
+bool ErrorStateKalmanFilter<Group>::Update(
+    const MeasurementVector<M>& residual,
+    const MeasurementJacobian<M>& jacobian,
+    const MeasurementCovariance<M>& noise_covariance) {
+  const Eigen::Matrix<Scalar, M, Dimension> jacobian_covariance =
+      jacobian * covariance_;
+  const MeasurementCovariance<M> innovation_covariance =
+      jacobian_covariance * jacobian.transpose() + noise_covariance;
+  const Eigen::LLT<MeasurementCovariance<M>> llt(innovation_covariance);
+  if (llt.info() != Eigen::Success) return false;
+
+  // K = P H^T S^{-1}, computed as the transpose of S^{-1} (H P).
+  const Eigen::Matrix<Scalar, Dimension, M> gain =
+      llt.solve(jacobian_covariance).transpose();
+  const TangentVector correction = gain * residual;
+  const Jacobian reduction = Jacobian::Identity() - gain * jacobian;
+  const Covariance corrected =
+      reduction * covariance_ * reduction.transpose() +
+      gain * noise_covariance * gain.transpose();
+
+  // X_true = X Exp(correction + e) ~= X Exp(correction) Exp(Jr e).
+  const Jacobian reset = Group::RightJacobian(correction);
+  state_ = state_.Rplus(correction);
+  covariance_ = reset * corrected * reset.transpose();
+  return true;
+}
+
+template <typename Group>
+bool ErrorStateKalmanFilter<Group>::Update(const Group& observation,
+                                           const Covariance& noise_covariance) {
+  const TangentVector residual = state_.Rminus(observation);
+  const Jacobian noise_jacobian = Group::RightJacobianInverse(residual);
+  return Update<Dimension>(
+      residual, Jacobian::Identity(),
+      noise_jacobian * noise_covariance * noise_jacobian.transpose());
+}
+
+template <typename Group>
+const Group& ErrorStateKalmanFilter<Group>::state() const {
+  return state_;
+}
+
+template <typename Group>
+const typename ErrorStateKalmanFilter<Group>::Covariance&
+ErrorStateKalmanFilter<Group>::covariance() const {
+  return covariance_;
+}
+
+}  // namespace mana
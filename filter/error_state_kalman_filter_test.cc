@@ -0,0 +1,212 @@
+// Fail on any heap allocation by Eigen while it is disallowed.
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include "filter/error_state_kalman_filter.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+using Matrix1d = SO2GroupElement::Jacobian;
+
+// A non-abelian test double: 3D rotations, with just the interface that the
+// filter uses.
+struct RotationGroup {
+  using Scalar = double;
+  using TangentVector = Eigen::Vector3d;
+  using Jacobian = Eigen::Matrix3d;
+  static constexpr int Dimension = 3;
+
+  static Eigen::Matrix3d Hat(const TangentVector& v) {
+    Eigen::Matrix3d hat;
+    hat << 0, -v(2), v(1), v(2), 0, -v(0), -v(1), v(0), 0;
+    return hat;
+  }
+  // Rodrigues' formula.
+  static RotationGroup Exp(const TangentVector& v) {
+    const double angle = v.norm();
+    const Eigen::Matrix3d hat = Hat(v);
+    if (angle < 1e-8) return {Eigen::Matrix3d::Identity() + hat};
+    return {Eigen::Matrix3d::Identity() + std::sin(angle) / angle * hat +
+            (1 - std::cos(angle)) / (angle * angle) * hat * hat};
+  }
+  TangentVector Log() const {
+    const Eigen::Matrix3d skew = (matrix - matrix.transpose()) / 2;
+    const TangentVector axis(skew(2, 1), skew(0, 2), skew(1, 0));
+    const double sin_angle = axis.norm();
+    if (sin_angle < 1e-12) return axis;
+    const double angle = std::atan2(sin_angle, (matrix.trace() - 1) / 2);
+    return angle / sin_angle * axis;
+  }
+  static Jacobian RightJacobian(const TangentVector& v) {
+    const double angle = v.norm();
+    const Eigen::Matrix3d hat = Hat(v);
+    if (angle < 1e-8) return Eigen::Matrix3d::Identity() - hat / 2;
+    return Eigen::Matrix3d::Identity() -
+           (1 - std::cos(angle)) / (angle * angle) * hat +
+           (angle - std::sin(angle)) / (angle * angle * angle) * hat * hat;
+  }
+  static Jacobian RightJacobianInverse(const TangentVector& v) {
+    return RightJacobian(v).inverse();
+  }
+  RotationGroup Inverse() const { return {matrix.transpose()}; }
+  RotationGroup Compose(const RotationGroup& rhs) const {
+    return {matrix * rhs.matrix};
+  }
+  Jacobian Adjoint() const { return matrix; }
+  RotationGroup Rplus(const TangentVector& v) const {
+    return Compose(Exp(v));
+  }
+  TangentVector Rminus(const RotationGroup& rhs) const {
+    return Inverse().Compose(rhs).Log();
+  }
+
+  Eigen::Matrix3d matrix = Eigen::Matrix3d::Identity();
+};
+
+// Draw samples of N(0, covariance).
+class GaussianSampler {
+ public:
+  explicit GaussianSampler(const Eigen::Matrix3d& covariance)
+      : sqrt_(covariance.llt().matrixL()) {}
+
+  Eigen::Vector3d operator()(std::mt19937& rng) {
+    Eigen::Vector3d z;
+    for (int i = 0; i < 3; ++i) z(i) = normal_(rng);
+    return sqrt_ * z;
+  }
+
+ private:
+  Eigen::Matrix3d sqrt_;
+  std::normal_distribution<double> normal_;
+};
+
+constexpr int kNumMonteCarloSamples = 200000;
+
+// Return the covariance of `sample_error(rng)` over Monte Carlo samples.
+template <typename SampleError>
+Eigen::Matrix3d MonteCarloCovariance(SampleError&& sample_error) {
+  std::mt19937 rng(/*seed=*/3);
+  Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+  for (int i = 0; i < kNumMonteCarloSamples; ++i) {
+    const Eigen::Vector3d error = sample_error(rng);
+    covariance += error * error.transpose();
+  }
+  return covariance / kNumMonteCarloSamples;
+}
+
+TEST(ErrorStateKalmanFilter, Predict) {
+  ErrorStateKalmanFilter<SO2GroupElement> filter(SO2GroupElement(0.5),
+                                                 Matrix1d(0.01));
+  for (int i = 0; i < 10; ++i) filter.Predict(Vector1d(0.2), Matrix1d(0.001));
+  EXPECT_TRUE(filter.state().EqualTo(SO2GroupElement(2.5), 1e-12));
+  EXPECT_NEAR(filter.covariance()(0, 0), 0.02, 1e-15);
+}
+
+TEST(ErrorStateKalmanFilter, UpdateObservation) {
+  ErrorStateKalmanFilter<SO2GroupElement> filter(SO2GroupElement(1.0),
+                                                 Matrix1d(0.04));
+  ASSERT_TRUE(filter.Update(SO2GroupElement(1.5), Matrix1d(0.01)));
+  // Scalar Kalman gain 0.04 / (0.04 + 0.01).
+  EXPECT_TRUE(filter.state().EqualTo(SO2GroupElement(1.4), 1e-12));
+  EXPECT_NEAR(filter.covariance()(0, 0), 0.008, 1e-15);
+
+  // A non positive definite innovation covariance is rejected.
+  EXPECT_FALSE(filter.Update(SO2GroupElement(1.5), Matrix1d(-1.0)));
+  EXPECT_TRUE(filter.state().EqualTo(SO2GroupElement(1.4), 1e-12));
+}
+
+TEST(ErrorStateKalmanFilter, UpdateBearing) {
+  // Track a heading from noiseless observations of the unit vector it points
+  // along, h(X) = X e1, with Jacobian dh/d(dx) = X [0; 1].
+  const SO2GroupElement truth(2.0);
+  ErrorStateKalmanFilter<SO2GroupElement> filter(SO2GroupElement(1.7),
+                                                 Matrix1d(0.25));
+  const Eigen::Vector2d measurement = truth.AsMatrix().col(0);
+  for (int i = 0; i < 5; ++i) {
+    const Eigen::Matrix2d rotation = filter.state().AsMatrix();
+    const Eigen::Vector2d residual = measurement - rotation.col(0);
+    const Eigen::Matrix<double, 2, 1> jacobian = rotation.col(1);
+    ASSERT_TRUE(filter.Update<2>(residual, jacobian,
+                                 1e-4 * Eigen::Matrix2d::Identity()));
+  }
+  EXPECT_TRUE(filter.state().EqualTo(truth, 1e-3));
+  EXPECT_LT(filter.covariance()(0, 0), 1e-4);
+}
+
+TEST(ErrorStateKalmanFilter, PredictNonAbelian) {
+  // The error of X.Rplus(dx).Rplus(u + w), dx ~ N(0, P), w ~ N(0, Q), in the
+  // tangent space of the prediction X.Rplus(u), which the filter transports P
+  // and maps Q into.
+  const RotationGroup state = RotationGroup::Exp(Eigen::Vector3d(0.3, -1.2, 2));
+  const Eigen::Vector3d increment(0.9, 0.6, -0.7);
+  const Eigen::Matrix3d covariance =
+      Eigen::Vector3d(4e-4, 1e-4, 2.5e-5).asDiagonal();
+  const Eigen::Matrix3d increment_covariance =
+      Eigen::Vector3d(1e-5, 9e-4, 1e-4).asDiagonal();
+  ErrorStateKalmanFilter<RotationGroup> filter(state, covariance);
+  filter.Predict(increment, increment_covariance);
+
+  GaussianSampler state_error(covariance);
+  GaussianSampler increment_error(increment_covariance);
+  const Eigen::Matrix3d expected =
+      MonteCarloCovariance([&](std::mt19937& rng) {
+        const RotationGroup truth =
+            state.Rplus(state_error(rng))
+                .Rplus(increment + increment_error(rng));
+        return filter.state().Rminus(truth);
+      });
+  EXPECT_LT((filter.covariance() - expected).norm(), 0.02 * expected.norm())
+      << filter.covariance() << "\nvs\n" << expected;
+}
+
+TEST(ErrorStateKalmanFilter, UpdateNonAbelian) {
+  // A direct observation of the full state, with a large residual: the
+  // corrected error e ~ N(0, P+), in the tangent space of the prior estimate
+  // X, is transported to the tangent space of X.Rplus(correction).
+  const RotationGroup state = RotationGroup::Exp(Eigen::Vector3d(-0.4, 1, 0.2));
+  const Eigen::Matrix3d covariance =
+      Eigen::Vector3d(9e-4, 1e-4, 4e-4).asDiagonal();
+  const Eigen::Vector3d residual(1.5, -0.3, 0.6);
+  const Eigen::Matrix3d noise_covariance =
+      Eigen::Vector3d(1e-4, 9e-4, 4e-4).asDiagonal();
+  ErrorStateKalmanFilter<RotationGroup> filter(state, covariance);
+  ASSERT_TRUE(filter.Update<3>(residual, Eigen::Matrix3d::Identity(),
+                               noise_covariance));
+
+  const Eigen::Matrix3d gain =
+      covariance * (covariance + noise_covariance).inverse();
+  const Eigen::Vector3d correction = gain * residual;
+  EXPECT_TRUE(filter.state().matrix.isApprox(
+      state.Rplus(correction).matrix, 1e-12));
+  GaussianSampler corrected_error(
+      (Eigen::Matrix3d::Identity() - gain) * covariance);
+  const Eigen::Matrix3d expected =
+      MonteCarloCovariance([&](std::mt19937& rng) {
+        const RotationGroup truth =
+            state.Rplus(correction + corrected_error(rng));
+        return filter.state().Rminus(truth);
+      });
+  EXPECT_LT((filter.covariance() - expected).norm(), 0.02 * expected.norm())
+      << filter.covariance() << "\nvs\n" << expected;
+}
+
+TEST(ErrorStateKalmanFilter, DoesNotAllocate) {
+  ErrorStateKalmanFilter<SO2GroupElement> filter(SO2GroupElement(0.0),
+                                                 Matrix1d(0.01));
+  Eigen::internal::set_is_malloc_allowed(false);
+  filter.Predict(Vector1d(0.1), Matrix1d(0.001));
+  filter.Update(SO2GroupElement(0.12), Matrix1d(0.01));
+  filter.Update<2>(Eigen::Vector2d(0.01, -0.02),
+                   Eigen::Matrix<double, 2, 1>(0.0, 1.0),
+                   Eigen::Matrix2d::Identity());
+  Eigen::internal::set_is_malloc_allowed(true);
+}
+
+}  // namespace mana
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "lie/base/manifold_array.h"
+#include "lie/base/mean.h"
+#include "lie/base/sampling.h"
+#include "utils/parallel.h"
+#include "utils/philox.h"
+
+namespace mana {
+
+// A bootstrap particle filter over a Lie group. Particles are held in
+// structure-of-arrays form (see lie/base/manifold_array.h), and the predict and
+// update steps are parallelized over particles under `Policy` (see
+// utils/parallel.h). Process noise and resampling offsets come from a
+// counter-based generator (see lie/base/sampling.h), so for a given seed the
+// filter's output is bitwise identical under any policy or thread count.
+//
+// All of the filter's storage is allocated at construction. Under
+// `SequentialExecution`, predicting, updating, and resampling never allocate;
+// under `ParallelExecution`, each of their parallel loops and reductions
+// allocates the shared state of its tasks (see utils/parallel.h).
+template <typename Group, typename Policy = SequentialExecution>
+class ParticleFilter {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using TangentBatch = typename Group::TangentBatch;
+  using Jacobian = typename Group::Jacobian;
+  using Particles = ManifoldArray<Group>;
+
+  // Construct from an initial (non-empty) set of equally weighted particles.
+  ParticleFilter(Particles particles, uint64_t seed,
+                 const Policy& policy = Policy());
+
+  // Move every particle by `increment` (expressed in the particle's frame)
+  // plus process noise drawn from N(0, L L'), where `L` is `noise_sqrt`:
+  //   X_i <- X_i.Rplus(increment + L z_i), z_i ~ N(0, I).
+  void Predict(const TangentVector& increment, const Jacobian& noise_sqrt);
+
+  // As above, with a separate increment per particle, stored column-wise.
+  void Predict(const TangentBatch& increments, const Jacobian& noise_sqrt);
+
+  // Reweight the particles by a measurement likelihood. `log_likelihood` is
+  // called on chunks of particles, concurrently under a parallel policy, as
+  //   log_likelihood(const Particles& particles, size_t begin, size_t end,
+  //                  Scalar* log_likelihoods);
+  // and must write log p(z | particles[i]) to log_likelihoods[i] for each i in
+  // [begin, end). It may process the chunk as a whole, e.g. over the columns
+  // particles.storage().middleCols(begin, end - begin).
+  //
+  // A particle whose log likelihood is not finite (NaN, or +-infinity) gets
+  // zero weight, as if its likelihood were zero, rather than invalidating
+  // the update. Returns false, leaving the weights unchanged, if no particle
+  // of nonzero weight has a finite log likelihood.
+  template <typename LogLikelihood>
+  bool Update(LogLikelihood&& log_likelihood);
+
+  // Draw a new, equally weighted set of particles from the current weights,
+  // with systematic resampling.
+  void Resample();
+
+  // Resample only if the effective sample size has fallen below
+  // `min_effective_fraction` of the number of particles. Returns whether the
+  // particles were resampled.
+  bool ResampleIfDegenerate(Scalar min_effective_fraction = 0.5);
+
+  // Return the effective sample size, 1 / sum_i w_i^2, which ranges from 1
+  // (all weight on one particle) to size() (equal weights).
+  Scalar EffectiveSampleSize() const;
+
+  // Return the weighted Karcher mean of the particles (see lie/base/mean.h).
+  Group Estimate(const MeanOptions& options = {}) const;
+
+  // Return the number of particles.
+  size_t size() const;
+
+  // Access the particles, and their normalized weights.
+  const Particles& particles() const;
+  const std::vector<Scalar>& weights() const;
+
+ private:
+  // Apply X_i <- X_i.Rplus(increment(i) + L z_i) to every particle.
+  template <typename IncrementFn>
+  void PredictImpl(IncrementFn&& increment, const Jacobian& noise_sqrt);
+
+  Policy policy_;
+  Philox4x32 philox_;
+  // Index of the next random stream to draw from; each predict and resample
+  // step uses a stream of its own.
+  uint32_t stream_ = 0;
+
+  Particles particles_;
+  std::vector<Scalar> weights_;
+
+  // Preallocated scratch space for the update and resample steps.
+  std::vector<Scalar> log_likelihoods_;
+  std::vector<size_t> indices_;
+  Particles resampled_;
+};
+
+template <typename Group, typename Policy>
+ParticleFilter<Group, Policy>::ParticleFilter(Particles particles,
+                                              uint64_t seed,
+                                              const Policy& policy)
+    : policy_(policy),
+      philox_(seed),
+      particles_(std::move(particles)),
+      weights_(particles_.size(), Scalar(1) / particles_.size()),
+      log_likelihoods_(particles_.size()),
+      indices_(particles_.size()),
+      resampled_(particles_.size()) {
+  assert(!particles_.empty());
+}
+
+template <typename Group, typename Policy>
+void ParticleFilter<Group, Policy>::Predict(const TangentVector& increment,
+                                            const Jacobian& noise_sqrt) {
+  PredictImpl([&](size_t) { return increment; }, noise_sqrt);
+}
+
+template <typename Group, typename Policy>
+void ParticleFilter<Group, Policy>::Predict(const TangentBatch& increments,
+                                            const Jacobian& noise_sqrt) {
+  assert(static_cast<size_t>(increments.cols()) == size());
+  PredictImpl([&](size_t i) { return TangentVector(increments.col(i)); },
+              noise_sqrt);
+}
+
+template <typename Group, typename Policy>
+template <typename IncrementFn>
+void ParticleFilter<Group, Policy>::PredictImpl(IncrementFn&& increment,
+                                                const Jacobian& noise_sqrt) {
+  const uint32_t stream = stream_++;
+  ParallelFor(policy_, size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const TangentVector step =
+          increment(i) +
+          noise_sqrt * StandardGaussianTangent<Group>(philox_, i, stream);
+      particles_.Set(i, particles_[i].Rplus(step));
+    }
+  });
+}
+
+template <typename Group, typename Policy>
+template <typename LogLikelihood>
+bool ParticleFilter<Group, Policy>::Update(LogLikelihood&& log_likelihood) {
+  ParallelFor(policy_, size(), [&](size_t begin, size_t end) {
+    log_likelihood(static_cast<const Particles&>(particles_), begin, end,
+                   log_likelihoods_.data());
+  });
+
+  // Overwrite the log likelihoods with the log posterior weights,
+  // log w_i + log p(z | X_i), treating particles of zero weight or with a
+  // non-finite log likelihood as having zero posterior weight.
+  std::vector<Scalar>& log_posterior = log_likelihoods_;
+  const Scalar max_log_posterior = ParallelReduce(
+      policy_, size(), -std::numeric_limits<Scalar>::infinity(),
+      [&](size_t begin, size_t end) {
+        Scalar partial = -std::numeric_limits<Scalar>::infinity();
+        for (size_t i = begin; i < end; ++i) {
+          log_posterior[i] =
+              weights_[i] > 0 && std::isfinite(log_likelihoods_[i])
+                  ? std::log(weights_[i]) + log_likelihoods_[i]
+                  : -std::numeric_limits<Scalar>::infinity();
+          partial = std::max(partial, log_posterior[i]);
+        }
+        return partial;
+      },
+      [](Scalar lhs, Scalar rhs) { return std::max(lhs, rhs); });
+  if (!std::isfinite(max_log_posterior)) return false;
+
+  // Scale the posterior weights by the largest one before exponentiating, so
+  // that they cannot all underflow.
+  std::vector<Scalar>& posterior = log_likelihoods_;
+  const Scalar total_weight = ParallelReduce(
+      policy_, size(), Scalar(0),
+      [&](size_t begin, size_t end) {
+        Scalar partial = 0;
+        for (size_t i = begin; i < end; ++i) {
+          posterior[i] = std::exp(log_posterior[i] - max_log_posterior);
+          partial += posterior[i];
+        }
+        return partial;
+      },
+      [](Scalar lhs, Scalar rhs) { return lhs + rhs; });
+
+  ParallelFor(policy_, size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      weights_[i] = posterior[i] / total_weight;
+    }
+  });
+  return true;
+}
+
+template <typename Group, typename Policy>
+void ParticleFilter<Group, Policy>::Resample() {
+  const Philox4x32::Block block = philox_({0, 0, 0, stream_++});
+  const Scalar offset =
+      static_cast<Scalar>(1 - ToUniform(block[0], block[1]));
+  SystematicResample(weights_, offset, indices_);
+  Gather(policy_, particles_, indices_, resampled_);
+  particles_.storage().swap(resampled_.storage());
+  std::fill(weights_.begin(), weights_.end(), Scalar(1) / size());
+}
+
+template <typename Group, typename Policy>
+bool ParticleFilter<Group, Policy>::ResampleIfDegenerate(
+    Scalar min_effective_fraction) {
+  if (EffectiveSampleSize() >= min_effective_fraction * size()) return false;
+  Resample();
+  return true;
+}
+
+template <typename Group, typename Policy>
+typename ParticleFilter<Group, Policy>::Scalar
+ParticleFilter<Group, Policy>::EffectiveSampleSize() const {
+  Scalar sum_squares = 0;
+  for (const Scalar weight : weights_) sum_squares += weight * weight;
+  return 1 / sum_squares;
+}
+
+template <typename Group, typename Policy>
+Group ParticleFilter<Group, Policy>::Estimate(
+    const MeanOptions& options) const {
+  return Mean(particles_.ToVector(), weights_, options, policy_);
+}
+
+template <typename Group, typename Policy>
+size_t ParticleFilter<Group, Policy>::size() const {
+  return particles_.size();
+}
+
+template <typename Group, typename Policy>
+const typename ParticleFilter<Group, Policy>::Particles&
+ParticleFilter<Group, Policy>::particles() const {
+  return particles_;
+}
+
+template <typename Group, typename Policy>
+const std::vector<typename ParticleFilter<Group, Policy>::Scalar>&
+ParticleFilter<Group, Policy>::weights() const {
+  return weights_;
+}
+
+}  // namespace mana
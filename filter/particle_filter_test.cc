@@ -0,0 +1,144 @@
+// Fail on any heap allocation by Eigen while it is disallowed.
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include "filter/particle_filter.h"
+
+#include <Eigen/Dense>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+
+// Count every allocation made through the global operator new.
+std::atomic<size_t> num_allocations{0};
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  if (void* pointer = std::malloc(size)) return pointer;
+  throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+// Von Mises measurement likelihood, log p(z | x) = kappa cos(x - z) + const,
+// evaluated over a chunk of particles directly from their (cos, sin) storage.
+auto HeadingLikelihood(const SO2GroupElement& measurement, double kappa) {
+  const double cos_z = std::cos(measurement.AngleRadians());
+  const double sin_z = std::sin(measurement.AngleRadians());
+  return [=](const ManifoldArray<SO2GroupElement>& particles, size_t begin,
+             size_t end, double* log_likelihoods) {
+    const auto chunk = particles.storage().middleCols(begin, end - begin);
+    Eigen::Map<Eigen::RowVectorXd> output(log_likelihoods + begin,
+                                          end - begin);
+    output = kappa * (cos_z * chunk.row(0) + sin_z * chunk.row(1));
+  };
+}
+
+template <typename Policy>
+SO2GroupElement TrackHeading(const Policy& policy) {
+  ParticleFilter<SO2GroupElement, Policy> filter(
+      ManifoldArray<SO2GroupElement>(5000, SO2GroupElement(0.0)),
+      /*seed=*/42, policy);
+  // Spread the initial particles over the whole circle.
+  filter.Predict(Vector1d(0.0), SO2GroupElement::Jacobian(3.0));
+
+  const double rate = 0.1;
+  for (int step = 1; step <= 30; ++step) {
+    filter.Predict(Vector1d(rate), SO2GroupElement::Jacobian(0.05));
+    const SO2GroupElement truth(0.5 + rate * step);
+    EXPECT_TRUE(filter.Update(HeadingLikelihood(truth, /*kappa=*/25.0)));
+    filter.ResampleIfDegenerate();
+  }
+  return filter.Estimate();
+}
+
+TEST(ParticleFilter, TracksHeading) {
+  const SO2GroupElement estimate = TrackHeading(SequentialExecution());
+  EXPECT_NEAR(estimate.Rminus(SO2GroupElement(3.5))(0), 0, 0.05);
+
+  // Reproducible under any execution policy.
+  const SO2GroupElement parallel_estimate =
+      TrackHeading(ParallelExecution{/*num_threads=*/4, /*grain_size=*/256});
+  EXPECT_EQ(estimate.AngleRadians(), parallel_estimate.AngleRadians());
+}
+
+TEST(ParticleFilter, UpdateAndResample) {
+  ParticleFilter<SO2GroupElement> filter(
+      ManifoldArray<SO2GroupElement>(std::vector<SO2GroupElement>{
+          SO2GroupElement(-1.0), SO2GroupElement(0.0), SO2GroupElement(1.0),
+          SO2GroupElement(2.0)}),
+      /*seed=*/1);
+  EXPECT_DOUBLE_EQ(filter.EffectiveSampleSize(), 4);
+
+  // Weight all mass onto the particles at 0 and 1, equally.
+  EXPECT_TRUE(filter.Update([](const ManifoldArray<SO2GroupElement>&,
+                               size_t begin, size_t end,
+                               double* log_likelihoods) {
+    for (size_t i = begin; i < end; ++i) {
+      log_likelihoods[i] = (i == 1 || i == 2) ? -1000.0 : -INFINITY;
+    }
+  }));
+  EXPECT_DOUBLE_EQ(filter.weights()[0], 0);
+  EXPECT_DOUBLE_EQ(filter.weights()[1], 0.5);
+  EXPECT_DOUBLE_EQ(filter.EffectiveSampleSize(), 2);
+
+  // A likelihood that vanishes everywhere leaves the weights unchanged.
+  EXPECT_FALSE(filter.Update(
+      [](const ManifoldArray<SO2GroupElement>&, size_t begin, size_t end,
+         double* log_likelihoods) {
+        for (size_t i = begin; i < end; ++i) log_likelihoods[i] = -INFINITY;
+      }));
+  EXPECT_DOUBLE_EQ(filter.weights()[1], 0.5);
+
+  // The likelihoods are scaled together with the prior weights, so a large
+  // likelihood on a particle of zero weight does not underflow the others,
+  // and a NaN likelihood only zeroes its own particle.
+  ParticleFilter<SO2GroupElement> copy = filter;
+  EXPECT_TRUE(copy.Update([](const ManifoldArray<SO2GroupElement>&,
+                             size_t begin, size_t end,
+                             double* log_likelihoods) {
+    const double values[] = {0.0, -1000.0, -1000.0 - std::log(3.0), NAN};
+    for (size_t i = begin; i < end; ++i) log_likelihoods[i] = values[i];
+  }));
+  EXPECT_EQ(copy.weights()[0], 0);
+  EXPECT_NEAR(copy.weights()[1], 0.75, 1e-12);
+  EXPECT_NEAR(copy.weights()[2], 0.25, 1e-12);
+  EXPECT_EQ(copy.weights()[3], 0);
+
+  EXPECT_FALSE(filter.ResampleIfDegenerate(/*min_effective_fraction=*/0.5));
+  EXPECT_TRUE(filter.ResampleIfDegenerate(/*min_effective_fraction=*/0.75));
+  EXPECT_DOUBLE_EQ(filter.EffectiveSampleSize(), 4);
+  for (size_t i = 0; i < filter.size(); ++i) {
+    EXPECT_EQ(filter.weights()[i], 0.25);
+  }
+  const std::vector<SO2GroupElement> particles = filter.particles().ToVector();
+  EXPECT_EQ(particles[0], SO2GroupElement(0.0));
+  EXPECT_EQ(particles[1], SO2GroupElement(0.0));
+  EXPECT_EQ(particles[2], SO2GroupElement(1.0));
+  EXPECT_EQ(particles[3], SO2GroupElement(1.0));
+}
+
+TEST(ParticleFilter, SequentialStepsDoNotAllocate) {
+  ParticleFilter<SO2GroupElement> filter(
+      ManifoldArray<SO2GroupElement>(1000, SO2GroupElement(0.0)),
+      /*seed=*/7, SequentialExecution{/*grain_size=*/64});
+  const auto likelihood =
+      HeadingLikelihood(SO2GroupElement(0.3), /*kappa=*/4.0);
+  const size_t allocations = num_allocations;
+  Eigen::internal::set_is_malloc_allowed(false);
+  filter.Predict(Vector1d(0.1), SO2GroupElement::Jacobian(0.5));
+  EXPECT_TRUE(filter.Update(likelihood));
+  filter.Resample();
+  EXPECT_TRUE(filter.ResampleIfDegenerate(/*min_effective_fraction=*/1.1));
+  Eigen::internal::set_is_malloc_allowed(true);
+  EXPECT_EQ(num_allocations, allocations);
+}
+
+}  // namespace mana
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "lie/base/manifold_array.h"
+#include "lie/base/mean.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+// A Gaussian distribution on a Lie group: X = mean.Rplus(dx), dx ~ N(0, P),
+// with its covariance P in the tangent space at the mean.
+template <typename Group>
+struct TangentGaussian {
+  Group mean;
+  typename Group::Jacobian covariance;
+};
+
+// Scaling parameters of the (scaled, symmetric) unscented transform, with
+// lambda = alpha^2 (N + kappa) - N for an N-dimensional input:
+// - `alpha` sets the spread of the sigma points around the mean,
+// - `beta` folds prior knowledge of the distribution's kurtosis into the
+//   covariance weight of the center point (2 is optimal for Gaussians),
+// - `kappa` is a secondary spread parameter.
+struct UnscentedParameters {
+  double alpha = 1;
+  double beta = 2;
+  double kappa = 0;
+};
+
+// Weights of the 2N + 1 sigma points of an N-dimensional input: the center
+// point, and each of the 2N points at +-(column of sqrt((N + lambda) P)).
+template <typename Scalar>
+struct UnscentedWeights {
+  Scalar center_mean;
+  Scalar center_covariance;
+  Scalar other;
+  // N + lambda, the squared scale of the sigma point offsets.
+  Scalar spread;
+
+  static UnscentedWeights Compute(int dimension,
+                                  const UnscentedParameters& parameters);
+};
+
+// Generate the 2N + 1 sigma points of `input`, mean.Rplus(0) followed by
+// mean.Rplus(+s_i) and mean.Rplus(-s_i) for each column s_i of the Cholesky
+// factor of (N + lambda) P. Returns nothing if P is not positive definite.
+template <typename Group>
+std::optional<ManifoldArray<Group>> GenerateSigmaPoints(
+    const TangentGaussian<Group>& input,
+    const UnscentedParameters& parameters = {});
+
+// Recover the Gaussian of a set of 2N + 1 (propagated) sigma points, ordered
+// as by `GenerateSigmaPoints()` for an N-dimensional input. The mean is found
+// by iterated weighted averaging of tangent vectors, starting from the center
+// point,
+//   X <- X.Rplus(sum_i w_i X.Rminus(Y_i)),
+// until the update is below `options.convergence_tolerance`. The covariance
+// is then sum_i w_i' X.Rminus(Y_i) X.Rminus(Y_i)^T.
+template <typename Group>
+TangentGaussian<Group> RecoverGaussian(
+    const ManifoldArray<Group>& sigma_points,
+    const UnscentedParameters& parameters = {},
+    const MeanOptions& options = {});
+
+// Propagate `input` through `fn`, with signature Output(const Input&), by the
+// unscented transform: the sigma points of `input` are mapped through `fn` in
+// one batched call, in parallel under `policy`, and the output's Gaussian is
+// recovered from the results. Returns nothing if the input covariance is not
+// positive definite.
+template <typename Output, typename Input, typename Fn,
+          typename Policy = SequentialExecution>
+std::optional<TangentGaussian<Output>> UnscentedTransform(
+    const TangentGaussian<Input>& input, Fn&& fn,
+    const UnscentedParameters& parameters = {},
+    const MeanOptions& options = {}, const Policy& policy = Policy());
+
+template <typename Scalar>
+/*static*/ UnscentedWeights<Scalar> UnscentedWeights<Scalar>::Compute(
+    int dimension, const UnscentedParameters& parameters) {
+  const Scalar alpha = parameters.alpha;
+  const Scalar lambda =
+      alpha * alpha * (dimension + parameters.kappa) - dimension;
+  const Scalar spread = dimension + lambda;
+  assert(spread > 0);
+  UnscentedWeights weights;
+  weights.center_mean = lambda / spread;
+  weights.center_covariance =
+      weights.center_mean + 1 - alpha * alpha + parameters.beta;
+  weights.other = 1 / (2 * spread);
+  weights.spread = spread;
+  return weights;
+}
+
+template <typename Group>
+std::optional<ManifoldArray<Group>> GenerateSigmaPoints(
+    const TangentGaussian<Group>& input,
+    const UnscentedParameters& parameters) {
+  using Scalar = typename Group::Scalar;
+  using Jacobian = typename Group::Jacobian;
+  constexpr int kDimension = Group::Dimension;
+  const auto weights =
+      UnscentedWeights<Scalar>::Compute(kDimension, parameters);
+  const Eigen::LLT<Jacobian> llt(weights.spread * input.covariance);
+  if (llt.info() != Eigen::Success) return std::nullopt;
+
+  const Jacobian offsets = llt.matrixL();
+  ManifoldArray<Group> sigma_points(2 * kDimension + 1, input.mean);
+  for (int i = 0; i < kDimension; ++i) {
+    sigma_points.Set(1 + 2 * i, input.mean.Rplus(offsets.col(i)));
+    sigma_points.Set(2 + 2 * i, input.mean.Rplus(-offsets.col(i)));
+  }
+  return sigma_points;
+}
+
+template <typename Group>
+TangentGaussian<Group> RecoverGaussian(
+    const ManifoldArray<Group>& sigma_points,
+    const UnscentedParameters& parameters, const MeanOptions& options) {
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Jacobian = typename Group::Jacobian;
+  assert(sigma_points.size() % 2 == 1);
+  const int input_dimension = (sigma_points.size() - 1) / 2;
+  const auto weights =
+      UnscentedWeights<Scalar>::Compute(input_dimension, parameters);
+
+  Group mean = sigma_points[0];
+  for (int iteration = 0; iteration < options.max_iterations; ++iteration) {
+    TangentVector update =
+        weights.center_mean * mean.Rminus(sigma_points[0]);
+    for (size_t i = 1; i < sigma_points.size(); ++i) {
+      update += weights.other * mean.Rminus(sigma_points[i]);
+    }
+    mean = mean.Rplus(update);
+    if (update.norm() < options.convergence_tolerance) break;
+  }
+
+  const TangentVector center = mean.Rminus(sigma_points[0]);
+  Jacobian covariance =
+      weights.center_covariance * center * center.transpose();
+  for (size_t i = 1; i < sigma_points.size(); ++i) {
+    const TangentVector deviation = mean.Rminus(sigma_points[i]);
+    covariance += weights.other * deviation * deviation.transpose();
+  }
+  return TangentGaussian<Group>{std::move(mean), covariance};
+}
+
+template <typename Output, typename Input, typename Fn, typename Policy>
+std::optional<TangentGaussian<Output>> UnscentedTransform(
+    const TangentGaussian<Input>& input, Fn&& fn,
+    const UnscentedParameters& parameters, const MeanOptions& options,
+    const Policy& policy) {
+  const std::optional<ManifoldArray<Input>> sigma_points =
+      GenerateSigmaPoints(input, parameters);
+  if (!sigma_points) return std::nullopt;
+  ManifoldArray<Output> propagated(sigma_points->size());
+  Transform(policy, *sigma_points, propagated, fn);
+  return RecoverGaussian(propagated, parameters, options);
+}
+
+}  // namespace mana
@@ -0,0 +1,66 @@
+#include "filter/unscented_transform.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "lie/base/sampling.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+using Matrix1d = SO2GroupElement::Jacobian;
+
+TEST(UnscentedTransform, SigmaPoints) {
+  const TangentGaussian<SO2GroupElement> input{SO2GroupElement(0.5),
+                                               Matrix1d(0.04)};
+  const auto sigma_points = GenerateSigmaPoints(input);
+  ASSERT_TRUE(sigma_points.has_value());
+  ASSERT_EQ(sigma_points->size(), 3);
+  // With the default parameters, N + lambda = N.
+  EXPECT_EQ((*sigma_points)[0], SO2GroupElement(0.5));
+  EXPECT_EQ((*sigma_points)[1], SO2GroupElement(0.7));
+  EXPECT_EQ((*sigma_points)[2], SO2GroupElement(0.3));
+
+  // Recovery inverts generation.
+  const TangentGaussian<SO2GroupElement> recovered =
+      RecoverGaussian(*sigma_points);
+  EXPECT_TRUE(recovered.mean.EqualTo(input.mean, 1e-12));
+  EXPECT_NEAR(recovered.covariance(0, 0), 0.04, 1e-12);
+
+  EXPECT_FALSE(GenerateSigmaPoints(TangentGaussian<SO2GroupElement>{
+                   SO2GroupElement(0.5), Matrix1d(-1.0)})
+                   .has_value());
+}
+
+TEST(UnscentedTransform, MatchesMonteCarlo) {
+  // A nonlinear map of headings, which stretches angles near 0.5 rad.
+  const auto fn = [](const SO2GroupElement& x) {
+    const double angle = x.AngleRadians();
+    return SO2GroupElement(angle + 0.5 * std::sin(2 * angle));
+  };
+  const TangentGaussian<SO2GroupElement> input{SO2GroupElement(0.2),
+                                               Matrix1d(0.01)};
+  const UnscentedParameters parameters{/*alpha=*/1, /*beta=*/2,
+                                       /*kappa=*/2};
+  const auto output = UnscentedTransform<SO2GroupElement>(
+      input, fn, parameters, MeanOptions(),
+      ParallelExecution{/*num_threads=*/2, /*grain_size=*/1});
+  ASSERT_TRUE(output.has_value());
+
+  constexpr size_t kNumSamples = 200000;
+  ManifoldArray<SO2GroupElement> samples(kNumSamples, input.mean);
+  PerturbGaussian(samples, Matrix1d(0.1), /*seed=*/3, /*stream=*/0);
+  std::vector<SO2GroupElement> propagated;
+  for (size_t i = 0; i < kNumSamples; ++i) propagated.push_back(fn(samples[i]));
+  const SO2GroupElement mean = Mean(propagated);
+  double variance = 0;
+  for (const SO2GroupElement& sample : propagated) {
+    variance += std::pow(mean.Rminus(sample)(0), 2) / kNumSamples;
+  }
+
+  EXPECT_NEAR(output->mean.Rminus(mean)(0), 0, 2e-3);
+  EXPECT_NEAR(output->covariance(0, 0), variance, 0.02 * variance);
+}
+
+}  // namespace mana
@@ -0,0 +1,86 @@
+// Measures the throughput, in samples per second, of planar IMU
+// preintegration over intervals of a few hundred samples. The baseline for
+// equal work is the same preintegration with its rotation matrix evaluated
+// by trigonometry at every sample, instead of by the small-angle recurrence.
+// Integrating the deltas alone, with one Exp per sample and no Jacobians or
+// covariance, is shown for scale. With g++ 12 -O2 on a Xeon, the recurrence
+// measured about 1.1x faster than trigonometry at every sample: the
+// covariance and Jacobian updates dominate the cost of a sample.
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstdio>
+
+#include "imu/planar_preintegration.h"
+#include "lie/base/constants.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr int kSamplesPerInterval = 400;
+constexpr size_t kIterations = 5000;
+constexpr double kDt = 0.0025;
+
+void Run() {
+  Eigen::RowVectorXd angular_rates(kSamplesPerInterval);
+  Eigen::Matrix2Xd accelerations(2, kSamplesPerInterval);
+  for (int i = 0; i < kSamplesPerInterval; ++i) {
+    angular_rates(i) = 0.8 + 0.5 * std::sin(0.01 * i);
+    accelerations.col(i) << 1.0 + std::cos(0.02 * i), -0.5 + 0.001 * i;
+  }
+
+  // Baseline: deltas only (no Jacobians or covariance), one Exp per sample.
+  const double naive = MeasureNanoseconds(
+      [&] {
+        SO2GroupElement rotation;
+        Eigen::Vector2d velocity = Eigen::Vector2d::Zero();
+        Eigen::Vector2d position = Eigen::Vector2d::Zero();
+        for (int i = 0; i < kSamplesPerInterval; ++i) {
+          const Eigen::Vector2d acceleration =
+              rotation.AsMatrix() * accelerations.col(i);
+          position += velocity * kDt + acceleration * (kDt * kDt / 2);
+          velocity += acceleration * kDt;
+          rotation = rotation.Rplus(
+              SO2GroupElement::TangentVector(angular_rates(i) * kDt));
+        }
+        DoNotOptimize(position);
+      },
+      kIterations);
+
+  const PlanarImuNoise noise{0.01, 0.1};
+  const auto preintegrate = [&](size_t resync_period) {
+    return MeasureNanoseconds(
+        [&] {
+          PlanarImuPreintegration preintegration({}, noise, resync_period);
+          preintegration.IntegrateBatch(angular_rates, accelerations, kDt);
+          DoNotOptimize(preintegration.covariance());
+        },
+        kIterations);
+  };
+  const double exact = preintegrate(/*resync_period=*/1);
+  const double preintegrated = preintegrate(kRecurrenceResyncPeriod);
+
+  std::printf("Planar IMU integration, %d samples per interval\n",
+              kSamplesPerInterval);
+  PrintBenchmark("Preintegration, cos/sin per sample",
+                 exact / kSamplesPerInterval, exact / kSamplesPerInterval);
+  PrintBenchmark("Preintegration, recurrence",
+                 preintegrated / kSamplesPerInterval,
+                 exact / kSamplesPerInterval);
+  PrintBenchmark("Deltas only, Exp per sample", naive / kSamplesPerInterval,
+                 exact / kSamplesPerInterval);
+  std::printf("%-40s %10.3g samples/s\n", "Preintegration, cos/sin",
+              1e9 * kSamplesPerInterval / exact);
+  std::printf("%-40s %10.3g samples/s\n", "Preintegration, recurrence",
+              1e9 * kSamplesPerInterval / preintegrated);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
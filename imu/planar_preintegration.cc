@@ -0,0 +1,213 @@
+#include "imu/planar_preintegration.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "lie/base/constants.h"
+
+namespace mana {
+namespace {
+
+// Increments up to this angle (in radians) are advanced by the polynomial
+// recurrence below, whose truncation error is below x^8 / 8! ~ 1e-15.
+constexpr double kMaxRecurrenceAngle = 0.05;
+
+// The rotation matrix of `angle`.
+Eigen::Matrix2d Rotation(double angle) {
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+  Eigen::Matrix2d rotation;
+  rotation << c, -s, s, c;
+  return rotation;
+}
+
+// The rotation matrix of a small `angle`, from the Taylor series of its
+// cosine and sine.
+Eigen::Matrix2d SmallAngleRotation(double angle) {
+  if (std::abs(angle) > kMaxRecurrenceAngle) return Rotation(angle);
+  const double x2 = angle * angle;
+  const double c = 1 - x2 / 2 * (1 - x2 / 12 * (1 - x2 / 30));
+  const double s = angle * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42)));
+  Eigen::Matrix2d rotation;
+  rotation << c, -s, s, c;
+  return rotation;
+}
+
+// Return J v, where J = [0, -1; 1, 0] is the derivative of a rotation matrix
+// with respect to its angle, at the identity.
+Eigen::Vector2d Perpendicular(const Eigen::Vector2d& v) {
+  return Eigen::Vector2d(-v.y(), v.x());
+}
+
+}  // namespace
+
+PlanarImuPreintegration::PlanarImuPreintegration(const PlanarImuBias& bias,
+                                                 const PlanarImuNoise& noise,
+                                                 size_t resync_period)
+    : bias_(bias), noise_(noise), resync_period_(resync_period) {
+  assert(resync_period > 0);
+}
+
+void PlanarImuPreintegration::Integrate(double angular_rate,
+                                        const Eigen::Vector2d& acceleration,
+                                        double dt) {
+  assert(dt > 0);
+  const double rate = angular_rate - bias_.gyroscope;
+  const Eigen::Vector2d body_acceleration = acceleration - bias_.accelerometer;
+  const Eigen::Matrix2d& rotation = delta_rotation_;
+  const Eigen::Vector2d rotated_acceleration = rotation * body_acceleration;
+  // Derivative of the rotated acceleration with respect to the delta angle.
+  const Eigen::Vector2d rotated_acceleration_by_angle =
+      Perpendicular(rotated_acceleration);
+  const double angle_by_gyroscope = -delta_time_;
+  const double half_dt2 = dt * dt / 2;
+
+  // Propagate the error covariance, with the discrete noise variances
+  // density^2 / dt:
+  //   P <- A P A^T + B_g var_g B_g^T + B_a var_a B_a^T.
+  // The transition A is the identity plus a few blocks,
+  //   A = I + [0 0 0; a_v 0 0; a_p dt*I 0],
+  // so A P A^T is applied as row and column updates rather than as dense
+  // products.
+  const Eigen::Vector2d velocity_by_angle = rotated_acceleration_by_angle * dt;
+  const Eigen::Vector2d position_by_angle =
+      rotated_acceleration_by_angle * half_dt2;
+  covariance_.middleRows<2>(3) += position_by_angle * covariance_.row(0) +
+                                  dt * covariance_.middleRows<2>(1);
+  covariance_.middleRows<2>(1) += velocity_by_angle * covariance_.row(0);
+  covariance_.middleCols<2>(3) +=
+      covariance_.col(0) * position_by_angle.transpose() +
+      dt * covariance_.middleCols<2>(1);
+  covariance_.middleCols<2>(1) +=
+      covariance_.col(0) * velocity_by_angle.transpose();
+  Eigen::Matrix<double, 5, 2> accelerometer_input;
+  accelerometer_input << 0, 0, rotation * dt, rotation * half_dt2;
+  const double gyroscope_variance =
+      noise_.gyroscope_density * noise_.gyroscope_density / dt;
+  const double accelerometer_variance =
+      noise_.accelerometer_density * noise_.accelerometer_density / dt;
+  covariance_(0, 0) += dt * dt * gyroscope_variance;
+  covariance_.noalias() += accelerometer_variance * accelerometer_input *
+                           accelerometer_input.transpose();
+
+  // Bias Jacobians, position first as it depends on the previous velocity.
+  position_by_gyroscope_ +=
+      velocity_by_gyroscope_ * dt +
+      rotated_acceleration_by_angle * angle_by_gyroscope * half_dt2;
+  position_by_accelerometer_ +=
+      velocity_by_accelerometer_ * dt - rotation * half_dt2;
+  velocity_by_gyroscope_ +=
+      rotated_acceleration_by_angle * angle_by_gyroscope * dt;
+  velocity_by_accelerometer_ -= rotation * dt;
+
+  // Deltas.
+  delta_position_ += delta_velocity_ * dt + rotated_acceleration * half_dt2;
+  delta_velocity_ += rotated_acceleration * dt;
+  delta_angle_ += rate * dt;
+  delta_time_ += dt;
+  ++num_samples_;
+  if (num_samples_ % resync_period_ == 0) {
+    delta_rotation_ = Rotation(delta_angle_);
+  } else {
+    delta_rotation_ = delta_rotation_ * SmallAngleRotation(rate * dt);
+  }
+}
+
+void PlanarImuPreintegration::IntegrateBatch(
+    const Eigen::RowVectorXd& angular_rates,
+    const Eigen::Matrix2Xd& accelerations, double dt) {
+  assert(angular_rates.cols() == accelerations.cols());
+  for (Eigen::Index i = 0; i < angular_rates.cols(); ++i) {
+    Integrate(angular_rates(i), accelerations.col(i), dt);
+  }
+}
+
+SO2GroupElement PlanarImuPreintegration::DeltaRotation() const {
+  return SO2GroupElement(delta_angle_);
+}
+
+const Eigen::Vector2d& PlanarImuPreintegration::DeltaVelocity() const {
+  return delta_velocity_;
+}
+
+const Eigen::Vector2d& PlanarImuPreintegration::DeltaPosition() const {
+  return delta_position_;
+}
+
+double PlanarImuPreintegration::DeltaTime() const { return delta_time_; }
+
+size_t PlanarImuPreintegration::NumSamples() const { return num_samples_; }
+
+SO2GroupElement PlanarImuPreintegration::DeltaRotation(
+    const PlanarImuBias& bias) const {
+  return SO2GroupElement(delta_angle_ + DeltaAngleByGyroscopeBias() *
+                                            (bias.gyroscope - bias_.gyroscope));
+}
+
+Eigen::Vector2d PlanarImuPreintegration::DeltaVelocity(
+    const PlanarImuBias& bias) const {
+  return delta_velocity_ +
+         velocity_by_gyroscope_ * (bias.gyroscope - bias_.gyroscope) +
+         velocity_by_accelerometer_ *
+             (bias.accelerometer - bias_.accelerometer);
+}
+
+Eigen::Vector2d PlanarImuPreintegration::DeltaPosition(
+    const PlanarImuBias& bias) const {
+  return delta_position_ +
+         position_by_gyroscope_ * (bias.gyroscope - bias_.gyroscope) +
+         position_by_accelerometer_ *
+             (bias.accelerometer - bias_.accelerometer);
+}
+
+PlanarNavState PlanarImuPreintegration::Predict(
+    const PlanarNavState& start, const Eigen::Vector2d& gravity) const {
+  return Predict(start, gravity, bias_);
+}
+
+PlanarNavState PlanarImuPreintegration::Predict(
+    const PlanarNavState& start, const Eigen::Vector2d& gravity,
+    const PlanarImuBias& bias) const {
+  const Eigen::Matrix2d rotation = start.rotation.AsMatrix();
+  const double dt = delta_time_;
+  PlanarNavState end;
+  end.rotation = start.rotation.Compose(DeltaRotation(bias));
+  end.velocity =
+      start.velocity + gravity * dt + rotation * DeltaVelocity(bias);
+  end.position = start.position + start.velocity * dt +
+                 gravity * (dt * dt / 2) + rotation * DeltaPosition(bias);
+  return end;
+}
+
+const PlanarImuPreintegration::Covariance&
+PlanarImuPreintegration::covariance() const {
+  return covariance_;
+}
+
+const PlanarImuBias& PlanarImuPreintegration::bias() const { return bias_; }
+
+double PlanarImuPreintegration::DeltaAngleByGyroscopeBias() const {
+  return -delta_time_;
+}
+
+const Eigen::Vector2d& PlanarImuPreintegration::DeltaVelocityByGyroscopeBias()
+    const {
+  return velocity_by_gyroscope_;
+}
+
+const Eigen::Matrix2d&
+PlanarImuPreintegration::DeltaVelocityByAccelerometerBias() const {
+  return velocity_by_accelerometer_;
+}
+
+const Eigen::Vector2d& PlanarImuPreintegration::DeltaPositionByGyroscopeBias()
+    const {
+  return position_by_gyroscope_;
+}
+
+const Eigen::Matrix2d&
+PlanarImuPreintegration::DeltaPositionByAccelerometerBias() const {
+  return position_by_accelerometer_;
+}
+
+}  // namespace mana
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+
+#include "lie/base/constants.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+// Navigation state of a planar body: its heading, and its velocity and
+// position in the world frame.
+struct PlanarNavState {
+  SO2GroupElement rotation;
+  Eigen::Vector2d velocity = Eigen::Vector2d::Zero();
+  Eigen::Vector2d position = Eigen::Vector2d::Zero();
+};
+
+// Biases of a planar IMU: a yaw-rate gyroscope and a two-axis accelerometer.
+struct PlanarImuBias {
+  double gyroscope = 0;
+  Eigen::Vector2d accelerometer = Eigen::Vector2d::Zero();
+};
+
+// Continuous-time white noise densities of a planar IMU, in rad/s/sqrt(Hz) and
+// m/s^2/sqrt(Hz).
+struct PlanarImuNoise {
+  double gyroscope_density = 0;
+  double accelerometer_density = 0;
+};
+
+// Preintegrated measurements of a planar IMU between two times i and j (e.g.
+// two spline knots), following Forster et al., "On-Manifold Preintegration for
+// Real-Time Visual-Inertial Odometry" (T-RO 2017), restricted to the plane.
+// The deltas
+//   dR = R_i^{-1} R_j,
+//   dv = R_i^{-1} (v_j - v_i - g dt),
+//   dp = R_i^{-1} (p_j - p_i - v_i dt - g dt^2 / 2)
+// are independent of the state at i, so they are integrated once per interval
+// at a linearization point of the biases. Their Jacobians with respect to the
+// biases are tracked analytically alongside, so that a change of bias
+// estimate is applied to first order without reintegrating, as is the
+// covariance of the deltas' errors.
+//
+// Integration uses fixed-size math only. The heading is accumulated exactly
+// as an angle (SO2 is abelian, so BCH is exact), while its rotation matrix is
+// advanced by a trigonometry-free small-angle recurrence, re-anchored to the
+// exact angle every `resync_period` samples (`kRecurrenceResyncPeriod` by
+// default; a period of 1 evaluates the rotation exactly at every sample).
+class PlanarImuPreintegration {
+ public:
+  // Error covariance of the deltas, ordered as [dtheta, dv, dp].
+  using Covariance = Eigen::Matrix<double, 5, 5>;
+
+  // Construct an empty preintegration, linearized at `bias`.
+  explicit PlanarImuPreintegration(
+      const PlanarImuBias& bias = {}, const PlanarImuNoise& noise = {},
+      size_t resync_period = kRecurrenceResyncPeriod);
+
+  // Integrate one sample of yaw rate and (specific force) acceleration, both
+  // measured in the body frame, held for `dt` seconds.
+  void Integrate(double angular_rate, const Eigen::Vector2d& acceleration,
+                 double dt);
+
+  // Integrate a batch of samples, one per column, each held for `dt`
+  // seconds. This is a convenience loop over `Integrate()`: each sample
+  // depends on the deltas of the previous one, so there is no batched inner
+  // loop to gain from.
+  void IntegrateBatch(const Eigen::RowVectorXd& angular_rates,
+                      const Eigen::Matrix2Xd& accelerations, double dt);
+
+  // Return the integrated deltas, at the linearization bias.
+  SO2GroupElement DeltaRotation() const;
+  const Eigen::Vector2d& DeltaVelocity() const;
+  const Eigen::Vector2d& DeltaPosition() const;
+  double DeltaTime() const;
+  size_t NumSamples() const;
+
+  // Return the integrated deltas, corrected to first order for `bias`.
+  SO2GroupElement DeltaRotation(const PlanarImuBias& bias) const;
+  Eigen::Vector2d DeltaVelocity(const PlanarImuBias& bias) const;
+  Eigen::Vector2d DeltaPosition(const PlanarImuBias& bias) const;
+
+  // Predict the state at j from the state at i, under gravity `gravity` (in
+  // the world frame), at the linearization bias or corrected for `bias`.
+  PlanarNavState Predict(const PlanarNavState& start,
+                         const Eigen::Vector2d& gravity) const;
+  PlanarNavState Predict(const PlanarNavState& start,
+                         const Eigen::Vector2d& gravity,
+                         const PlanarImuBias& bias) const;
+
+  // Return the error covariance of the deltas.
+  const Covariance& covariance() const;
+
+  // Return the bias the deltas are linearized at.
+  const PlanarImuBias& bias() const;
+
+  // Return the Jacobians of the deltas with respect to the gyroscope and
+  // accelerometer biases.
+  double DeltaAngleByGyroscopeBias() const;
+  const Eigen::Vector2d& DeltaVelocityByGyroscopeBias() const;
+  const Eigen::Matrix2d& DeltaVelocityByAccelerometerBias() const;
+  const Eigen::Vector2d& DeltaPositionByGyroscopeBias() const;
+  const Eigen::Matrix2d& DeltaPositionByAccelerometerBias() const;
+
+ private:
+  PlanarImuBias bias_;
+  PlanarImuNoise noise_;
+  size_t resync_period_;
+
+  // The integrated deltas. The heading is held both as an exact angle and as
+  // the (recurrence-updated) rotation matrix of that angle.
+  double delta_angle_ = 0;
+  Eigen::Matrix2d delta_rotation_ = Eigen::Matrix2d::Identity();
+  Eigen::Vector2d delta_velocity_ = Eigen::Vector2d::Zero();
+  Eigen::Vector2d delta_position_ = Eigen::Vector2d::Zero();
+  double delta_time_ = 0;
+  size_t num_samples_ = 0;
+  Covariance covariance_ = Covariance::Zero();
+
+  // Jacobians of the deltas with respect to the biases. The angle's Jacobian
+  // with respect to the gyroscope bias is -delta_time_.
+  Eigen::Vector2d velocity_by_gyroscope_ = Eigen::Vector2d::Zero();
+  Eigen::Matrix2d velocity_by_accelerometer_ = Eigen::Matrix2d::Zero();
+  Eigen::Vector2d position_by_gyroscope_ = Eigen::Vector2d::Zero();
+  Eigen::Matrix2d position_by_accelerometer_ = Eigen::Matrix2d::Zero();
+};
+
+}  // namespace mana
@@ -0,0 +1,165 @@
+#include "imu/planar_preintegration.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+// Yaw rate and body acceleration of a test trajectory at time `t`.
+double AngularRate(double t) { return 0.8 + 0.5 * std::sin(3 * t); }
+Eigen::Vector2d Acceleration(double t) {
+  return Eigen::Vector2d(1.0 + std::cos(2 * t), -0.5 + 0.3 * t);
+}
+
+constexpr int kNumSamples = 1000;
+constexpr double kDt = 0.002;
+
+PlanarImuPreintegration Preintegrate(const PlanarImuBias& bias) {
+  PlanarImuPreintegration preintegration(bias);
+  for (int i = 0; i < kNumSamples; ++i) {
+    preintegration.Integrate(AngularRate(i * kDt), Acceleration(i * kDt), kDt);
+  }
+  return preintegration;
+}
+
+TEST(PlanarImuPreintegration, MatchesStateIntegration) {
+  const Eigen::Vector2d gravity(0.0, -9.81);
+  const PlanarNavState start{SO2GroupElement(0.4), Eigen::Vector2d(1.0, 2.0),
+                             Eigen::Vector2d(-3.0, 5.0)};
+
+  // Integrate the state directly, one Exp per sample.
+  PlanarNavState state = start;
+  for (int i = 0; i < kNumSamples; ++i) {
+    const Eigen::Vector2d acceleration =
+        gravity + state.rotation.AsMatrix() * Acceleration(i * kDt);
+    state.position += state.velocity * kDt + acceleration * (kDt * kDt / 2);
+    state.velocity += acceleration * kDt;
+    state.rotation = state.rotation.Rplus(
+        SO2GroupElement::TangentVector(AngularRate(i * kDt) * kDt));
+  }
+
+  const PlanarImuPreintegration preintegration = Preintegrate({});
+  EXPECT_EQ(preintegration.NumSamples(), kNumSamples);
+  EXPECT_NEAR(preintegration.DeltaTime(), kNumSamples * kDt, 1e-12);
+  const PlanarNavState predicted = preintegration.Predict(start, gravity);
+  EXPECT_TRUE(predicted.rotation.EqualTo(state.rotation, 1e-12));
+  EXPECT_TRUE(predicted.velocity.isApprox(state.velocity, 1e-12));
+  EXPECT_TRUE(predicted.position.isApprox(state.position, 1e-12));
+}
+
+TEST(PlanarImuPreintegration, BiasJacobians) {
+  const PlanarImuBias bias{0.01, Eigen::Vector2d(0.02, -0.03)};
+  const PlanarImuPreintegration preintegration = Preintegrate(bias);
+
+  // Compare to central finite differences of reintegration.
+  constexpr double kStep = 1e-6;
+  PlanarImuBias plus = bias;
+  PlanarImuBias minus = bias;
+  plus.gyroscope += kStep;
+  minus.gyroscope -= kStep;
+  const auto velocity_derivative = [&] {
+    return Eigen::Vector2d((Preintegrate(plus).DeltaVelocity() -
+                            Preintegrate(minus).DeltaVelocity()) /
+                           (2 * kStep));
+  };
+  const auto position_derivative = [&] {
+    return Eigen::Vector2d((Preintegrate(plus).DeltaPosition() -
+                            Preintegrate(minus).DeltaPosition()) /
+                           (2 * kStep));
+  };
+  EXPECT_TRUE(preintegration.DeltaVelocityByGyroscopeBias().isApprox(
+      velocity_derivative(), 1e-6));
+  EXPECT_TRUE(preintegration.DeltaPositionByGyroscopeBias().isApprox(
+      position_derivative(), 1e-6));
+  for (int k = 0; k < 2; ++k) {
+    plus = bias;
+    minus = bias;
+    plus.accelerometer(k) += kStep;
+    minus.accelerometer(k) -= kStep;
+    EXPECT_TRUE(preintegration.DeltaVelocityByAccelerometerBias().col(k)
+                    .isApprox(velocity_derivative(), 1e-6));
+    EXPECT_TRUE(preintegration.DeltaPositionByAccelerometerBias().col(k)
+                    .isApprox(position_derivative(), 1e-6));
+  }
+
+  // First-order bias correction is accurate to second order in the change.
+  const PlanarImuBias corrected{0.012, Eigen::Vector2d(0.021, -0.028)};
+  const PlanarImuPreintegration reintegrated = Preintegrate(corrected);
+  EXPECT_TRUE(preintegration.DeltaRotation(corrected).EqualTo(
+      reintegrated.DeltaRotation(), 1e-12));
+  EXPECT_LT((preintegration.DeltaVelocity(corrected) -
+             reintegrated.DeltaVelocity())
+                .norm(),
+            1e-5);
+  EXPECT_LT((preintegration.DeltaPosition(corrected) -
+             reintegrated.DeltaPosition())
+                .norm(),
+            1e-5);
+}
+
+TEST(PlanarImuPreintegration, Covariance) {
+  // Without rotation or acceleration, the noise is a random walk in angle and
+  // velocity, and its integral in position.
+  const PlanarImuNoise noise{/*gyroscope_density=*/0.01,
+                             /*accelerometer_density=*/0.1};
+  PlanarImuPreintegration preintegration({}, noise);
+  for (int i = 0; i < kNumSamples; ++i) {
+    preintegration.Integrate(0.0, Eigen::Vector2d::Zero(), kDt);
+  }
+  const double t = kNumSamples * kDt;
+  const PlanarImuPreintegration::Covariance& covariance =
+      preintegration.covariance();
+  EXPECT_NEAR(covariance(0, 0), 1e-4 * t, 1e-15);
+  EXPECT_NEAR(covariance(1, 1), 1e-2 * t, 1e-15);
+  EXPECT_NEAR(covariance(3, 3), 1e-2 * t * t * t / 3, 1e-5);
+  EXPECT_NEAR(covariance(1, 2), 0, 1e-15);
+}
+
+TEST(PlanarImuPreintegration, CovarianceMatchesDensePropagation) {
+  // Rotating and accelerating, compare the sparse update against dense
+  // P <- A P A^T + B Q B^T, with A and B built in full at every sample.
+  const PlanarImuNoise noise{/*gyroscope_density=*/0.01,
+                             /*accelerometer_density=*/0.1};
+  PlanarImuPreintegration preintegration({}, noise);
+  using Matrix5d = PlanarImuPreintegration::Covariance;
+  Matrix5d expected = Matrix5d::Zero();
+  double angle = 0;
+  for (int i = 0; i < kNumSamples; ++i) {
+    const double rate = AngularRate(i * kDt);
+    const Eigen::Vector2d acceleration = Acceleration(i * kDt);
+    const Eigen::Matrix2d rotation = SO2GroupElement(angle).AsMatrix();
+    Eigen::Matrix2d perpendicular;
+    perpendicular << 0, -1, 1, 0;
+    const Eigen::Vector2d rotated_by_angle =
+        perpendicular * rotation * acceleration;
+
+    Matrix5d transition = Matrix5d::Identity();
+    transition.block<2, 1>(1, 0) = rotated_by_angle * kDt;
+    transition.block<2, 1>(3, 0) = rotated_by_angle * kDt * kDt / 2;
+    transition.block<2, 2>(3, 1) = Eigen::Matrix2d::Identity() * kDt;
+    Eigen::Matrix<double, 5, 3> input = Eigen::Matrix<double, 5, 3>::Zero();
+    input(0, 0) = kDt;
+    input.block<2, 2>(1, 1) = rotation * kDt;
+    input.block<2, 2>(3, 1) = rotation * kDt * kDt / 2;
+    const Eigen::Vector3d variances =
+        Eigen::Vector3d(noise.gyroscope_density * noise.gyroscope_density,
+                        noise.accelerometer_density *
+                            noise.accelerometer_density,
+                        noise.accelerometer_density *
+                            noise.accelerometer_density) /
+        kDt;
+    expected = transition * expected * transition.transpose() +
+               input * variances.asDiagonal() * input.transpose();
+
+    preintegration.Integrate(rate, acceleration, kDt);
+    angle += rate * kDt;
+  }
+  EXPECT_TRUE(preintegration.covariance().isApprox(expected, 1e-12));
+  // The rotation couples the heading error into velocity and position.
+  EXPECT_GT(std::abs(expected(0, 3)), 1e-6);
+}
+
+}  // namespace mana
@@ -138,7 +138,7 @@ typename AlgebraElement<Derived>::Element AlgebraElement<Derived>::Compose(
 template <typename Derived>
 typename AlgebraElement<Derived>::Element AlgebraElement<Derived>::operator+(
     const Element& rhs) const {
-  return Element(coordinates_ + rhs.coordinates_);
+  return Element(Vector(coordinates_ + rhs.coordinates_));
 }
 
 template <typename Derived>
@@ -151,7 +151,7 @@ typename AlgebraElement<Derived>::Element& AlgebraElement<Derived>::operator+=(
 template <typename Derived>
 typename AlgebraElement<Derived>::Element AlgebraElement<Derived>::operator-(
     const Element& rhs) const {
-  return Element(coordinates_ - rhs.coordinates_);
+  return Element(Vector(coordinates_ - rhs.coordinates_));
 }
 
 template <typename Derived>
@@ -178,13 +178,13 @@ typename AlgebraElement<Derived>::Element& AlgebraElement<Derived>::operator*=(
 template <typename Derived>
 typename AlgebraElement<Derived>::Element AlgebraElement<Derived>::operator-()
     const {
-  return Element(-coordinates_);
+  return Element(Vector(-coordinates_));
 }
 
 template <typename Derived>
 typename AlgebraElement<Derived>::Element AlgebraElement<Derived>::operator*(
     Scalar rhs) const {
-  return Element(coordinates_ * rhs);
+  return Element(Vector(coordinates_ * rhs));
 }
 
 template <typename Derived>
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+
+namespace mana {
+
+// Kernels that the `ManifoldArray` algorithms (see manifold_array.h) run on
+// each chunk of structure-of-arrays storage, one coordinate row at a time.
+//
+// The default reads each element out of the storage, applies the group
+// operation, and writes it back, one element at a time. A specialization may
+// instead compute on the rows directly with Eigen array expressions, which
+// vectorize, as long as it matches the element-wise operation up to rounding.
+template <typename T>
+struct ArrayKernels {
+  using Scalar = typename T::Scalar;
+  using Storage = Eigen::Matrix<Scalar, T::StorageDimension, Eigen::Dynamic,
+                                Eigen::RowMajor>;
+
+  // Set column i of `output` to the composition of columns i of `lhs` and
+  // `rhs`, for i in [begin, end). `output` may alias `lhs` or `rhs`.
+  static void Compose(const Storage& lhs, const Storage& rhs, size_t begin,
+                      size_t end, Storage& output);
+};
+
+template <typename T>
+/*static*/ void ArrayKernels<T>::Compose(const Storage& lhs,
+                                         const Storage& rhs, size_t begin,
+                                         size_t end, Storage& output) {
+  Scalar lhs_coordinates[T::StorageDimension];
+  Scalar rhs_coordinates[T::StorageDimension];
+  Scalar coordinates[T::StorageDimension];
+  for (size_t i = begin; i < end; ++i) {
+    for (int k = 0; k < T::StorageDimension; ++k) {
+      lhs_coordinates[k] = lhs(k, i);
+      rhs_coordinates[k] = rhs(k, i);
+    }
+    T::FromStorage(lhs_coordinates)
+        .Compose(T::FromStorage(rhs_coordinates))
+        .ToStorage(coordinates);
+    for (int k = 0; k < T::StorageDimension; ++k) {
+      output(k, i) = coordinates[k];
+    }
+  }
+}
+
+}  // namespace mana
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace mana {
 
 template <typename ScalarT>
@@ -7,4 +9,9 @@ struct Constants {
   static constexpr ScalarT kEpsilon = 1e-8;
 };
 
+// Number of steps an incremental (multiplicative) recurrence may take before
+// it is re-anchored to an exactly evaluated element, bounding the accumulation
+// of rounding error.
+inline constexpr size_t kRecurrenceResyncPeriod = 64;
+
 }  // namespace mana
\ No newline at end of file
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstddef>
+
+#include "lie/base/manifold_array.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+// A fixed-size array of symmetric `Dimension` x `Dimension` matrices (e.g. the
+// tangent space covariances of many poses or landmarks), each stored as its
+// packed upper triangle, which halves the memory (and bandwidth) of storing it
+// in full. Storage is in structure-of-arrays form, like `ManifoldArray`:
+// packed coefficient k of every matrix is contiguous in row k of `storage()`.
+// Coefficients are packed row by row, so (r, c) with r <= c is at
+//   r * Dimension - r * (r - 1) / 2 + (c - r).
+template <typename ScalarT, int Dimension>
+class CovarianceArray {
+ public:
+  using Scalar = ScalarT;
+  using Matrix = Eigen::Matrix<Scalar, Dimension, Dimension>;
+  static constexpr int PackedDimension = Dimension * (Dimension + 1) / 2;
+  using Storage =
+      Eigen::Matrix<Scalar, PackedDimension, Eigen::Dynamic, Eigen::RowMajor>;
+  using Packed = Eigen::Matrix<Scalar, PackedDimension, 1>;
+
+  // Construct an array of `size` copies of `value`, which must be symmetric.
+  explicit CovarianceArray(size_t size = 0,
+                           const Matrix& value = Matrix::Zero());
+
+  // Return the index of coefficient (row, col) in a packed upper triangle.
+  static constexpr int PackedIndex(int row, int col);
+
+  // Return the number of matrices.
+  size_t size() const;
+  bool empty() const;
+
+  // Read (a copy of) the full matrix at `index`.
+  Matrix operator[](size_t index) const;
+
+  // Overwrite the matrix at `index` with the upper triangle of `value`.
+  void Set(size_t index, const Matrix& value);
+
+  // Return the packed upper triangle of J P J^T, where P is the matrix at
+  // `index`, computed from the packed coefficients without unpacking P.
+  Packed PackedCongruence(size_t index, const Matrix& jacobian) const;
+
+  // Access the underlying structure-of-arrays storage.
+  const Storage& storage() const;
+  Storage& storage();
+
+ private:
+  Storage storage_;
+};
+
+// The covariances of the elements of a `ManifoldArray<Group>`.
+template <typename Group>
+using GroupCovarianceArray =
+    CovarianceArray<typename Group::Scalar, Group::Dimension>;
+
+// Set each covariance[i] <- J_i covariance[i] J_i^T, where J_i = jacobian(i),
+// e.g. to push covariances through a batch of (linearized) functions.
+template <typename Policy, typename Scalar, int Dimension, typename JacobianFn>
+void PropagateCovariance(const Policy& policy,
+                         CovarianceArray<Scalar, Dimension>& covariances,
+                         JacobianFn&& jacobian);
+
+// Propagate right (body frame) tangent covariances through inversion: the
+// inverse of X.Rplus(dx) is X^{-1}.Rplus(-Ad(X) dx), so
+//   covariance[i] <- Ad(X_i) covariance[i] Ad(X_i)^T.
+// A no-op for abelian groups, whose adjoint is the identity.
+template <typename Policy, typename Group>
+void PropagateInverse(const Policy& policy,
+                      const ManifoldArray<Group>& elements,
+                      GroupCovarianceArray<Group>& covariances);
+
+// Propagate right tangent covariances through composition Z_i = X_i Y_i, of
+// elements with independent errors:
+//   dz = Ad(Y^{-1}) dx + dy,
+//   output[i] = Ad(Y_i^{-1}) lhs[i] Ad(Y_i^{-1})^T + rhs[i].
+// `output` must have the same size as the inputs, and may alias either.
+template <typename Policy, typename Group>
+void PropagateCompose(const Policy& policy,
+                      const GroupCovarianceArray<Group>& lhs_covariances,
+                      const ManifoldArray<Group>& rhs,
+                      const GroupCovarianceArray<Group>& rhs_covariances,
+                      GroupCovarianceArray<Group>& output);
+
+template <typename ScalarT, int Dimension>
+CovarianceArray<ScalarT, Dimension>::CovarianceArray(size_t size,
+                                                     const Matrix& value)
+    : storage_(PackedDimension, size) {
+  if (size > 0) {
+    Set(0, value);
+    for (size_t i = 1; i < size; ++i) storage_.col(i) = storage_.col(0);
+  }
+}
+
+template <typename ScalarT, int Dimension>
+/*static*/ constexpr int CovarianceArray<ScalarT, Dimension>::PackedIndex(
+    int row, int col) {
+  if (row > col) return PackedIndex(col, row);
+  return row * Dimension - row * (row - 1) / 2 + (col - row);
+}
+
+template <typename ScalarT, int Dimension>
+size_t CovarianceArray<ScalarT, Dimension>::size() const {
+  return storage_.cols();
+}
+
+template <typename ScalarT, int Dimension>
+bool CovarianceArray<ScalarT, Dimension>::empty() const {
+  return size() == 0;
+}
+
+template <typename ScalarT, int Dimension>
+typename CovarianceArray<ScalarT, Dimension>::Matrix
+CovarianceArray<ScalarT, Dimension>::operator[](size_t index) const {
+  assert(index < size());
+  Matrix matrix;
+  for (int r = 0, k = 0; r < Dimension; ++r) {
+    for (int c = r; c < Dimension; ++c, ++k) {
+      matrix(r, c) = storage_(k, index);
+      matrix(c, r) = storage_(k, index);
+    }
+  }
+  return matrix;
+}
+
+template <typename ScalarT, int Dimension>
+void CovarianceArray<ScalarT, Dimension>::Set(size_t index,
+                                              const Matrix& value) {
+  assert(index < size());
+  for (int r = 0, k = 0; r < Dimension; ++r) {
+    for (int c = r; c < Dimension; ++c, ++k) storage_(k, index) = value(r, c);
+  }
+}
+
+template <typename ScalarT, int Dimension>
+typename CovarianceArray<ScalarT, Dimension>::Packed
+CovarianceArray<ScalarT, Dimension>::PackedCongruence(
+    size_t index, const Matrix& jacobian) const {
+  assert(index < size());
+  // (J P)(r, b) = sum_a J(r, a) P(a, b), reading P(a, b) from its packed
+  // coefficient; then only the upper triangle of (J P) J^T is formed.
+  Matrix product;
+  for (int r = 0; r < Dimension; ++r) {
+    for (int b = 0; b < Dimension; ++b) {
+      Scalar sum = 0;
+      for (int a = 0; a < Dimension; ++a) {
+        sum += jacobian(r, a) * storage_(PackedIndex(a, b), index);
+      }
+      product(r, b) = sum;
+    }
+  }
+  Packed packed;
+  for (int r = 0, k = 0; r < Dimension; ++r) {
+    for (int c = r; c < Dimension; ++c, ++k) {
+      packed(k) = product.row(r).dot(jacobian.row(c));
+    }
+  }
+  return packed;
+}
+
+template <typename ScalarT, int Dimension>
+const typename CovarianceArray<ScalarT, Dimension>::Storage&
+CovarianceArray<ScalarT, Dimension>::storage() const {
+  return storage_;
+}
+
+template <typename ScalarT, int Dimension>
+typename CovarianceArray<ScalarT, Dimension>::Storage&
+CovarianceArray<ScalarT, Dimension>::storage() {
+  return storage_;
+}
+
+template <typename Policy, typename Scalar, int Dimension, typename JacobianFn>
+void PropagateCovariance(const Policy& policy,
+                         CovarianceArray<Scalar, Dimension>& covariances,
+                         JacobianFn&& jacobian) {
+  using Matrix = typename CovarianceArray<Scalar, Dimension>::Matrix;
+  ParallelFor(policy, covariances.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Matrix jacobian_i = jacobian(i);
+      covariances.storage().col(i) =
+          covariances.PackedCongruence(i, jacobian_i);
+    }
+  });
+}
+
+template <typename Policy, typename Group>
+void PropagateInverse(const Policy& policy,
+                      const ManifoldArray<Group>& elements,
+                      GroupCovarianceArray<Group>& covariances) {
+  assert(covariances.size() == elements.size());
+  if constexpr (!Group::IsAbelian) {
+    PropagateCovariance(policy, covariances,
+                        [&](size_t i) { return elements[i].Adjoint(); });
+  }
+}
+
+template <typename Policy, typename Group>
+void PropagateCompose(const Policy& policy,
+                      const GroupCovarianceArray<Group>& lhs_covariances,
+                      const ManifoldArray<Group>& rhs,
+                      const GroupCovarianceArray<Group>& rhs_covariances,
+                      GroupCovarianceArray<Group>& output) {
+  using Jacobian = typename Group::Jacobian;
+  assert(lhs_covariances.size() == rhs.size());
+  assert(rhs_covariances.size() == rhs.size());
+  assert(output.size() == rhs.size());
+  if constexpr (Group::IsAbelian) {
+    // Both adjoints are the identity: add the packed storage directly.
+    ParallelFor(policy, rhs.size(), [&](size_t begin, size_t end) {
+      output.storage().middleCols(begin, end - begin) =
+          lhs_covariances.storage().middleCols(begin, end - begin) +
+          rhs_covariances.storage().middleCols(begin, end - begin);
+    });
+  } else {
+    ParallelFor(policy, rhs.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        const Jacobian adjoint = rhs[i].Inverse().Adjoint();
+        output.storage().col(i) =
+            lhs_covariances.PackedCongruence(i, adjoint) +
+            rhs_covariances.storage().col(i);
+      }
+    });
+  }
+}
+
+}  // namespace mana
@@ -2,29 +2,31 @@
 
 namespace mana {
 
-// Base CRTP class for an element of a group.
+// Base CRTP class for an element of a group. Group operations return
+// `Element`s, which are `Derived` unless `Derived` is a view onto the storage
+// of another element type (see map.h).
 //
 // Derived classes must implement these methods.
-// - static Derived IdentityImpl();
-// - Derived InverseImpl() const;
-// - Derived ComposeImpl(const Derived& rhs) const;
-template <typename Derived>
+// - static Element IdentityImpl();
+// - Element InverseImpl() const;
+// - Element ComposeImpl(const Element& rhs) const;
+template <typename Derived, typename Element = Derived>
 class GroupElement {
  public:
   // Identity element of this group.
-  static Derived Identity();
+  static Element Identity();
 
   // Inverse of this group element.
-  Derived Inverse() const;
+  Element Inverse() const;
 
   // Composition of group elements.
-  Derived Compose(const Derived& rhs) const;
+  Element Compose(const Element& rhs) const;
 
   // Helper for X^{-1} * Y.
-  Derived BetweenInner(const Derived& rhs) const;
+  Element BetweenInner(const Element& rhs) const;
 
   // Helper for X * Y^{-1}.
-  Derived BetweenOuter(const Derived& rhs) const;
+  Element BetweenOuter(const Element& rhs) const;
 
  private:
   // CRTP helpers.
@@ -32,28 +34,28 @@ class GroupElement {
   const Derived& derived() const { return static_cast<const Derived&>(*this); }
 };
 
-template <typename Derived>
-/*static*/ Derived GroupElement<Derived>::Identity() {
+template <typename Derived, typename Element>
+/*static*/ Element GroupElement<Derived, Element>::Identity() {
   return Derived::IdentityImpl();
 }
 
-template <typename Derived>
-Derived GroupElement<Derived>::Inverse() const {
+template <typename Derived, typename Element>
+Element GroupElement<Derived, Element>::Inverse() const {
   return derived().InverseImpl();
 }
 
-template <typename Derived>
-Derived GroupElement<Derived>::Compose(const Derived& rhs) const {
+template <typename Derived, typename Element>
+Element GroupElement<Derived, Element>::Compose(const Element& rhs) const {
   return derived().ComposeImpl(rhs);
 }
 
-template <typename Derived>
-Derived GroupElement<Derived>::BetweenInner(const Derived& rhs) const {
+template <typename Derived, typename Element>
+Element GroupElement<Derived, Element>::BetweenInner(const Element& rhs) const {
   return Inverse().Compose(rhs);
 }
 
-template <typename Derived>
-Derived GroupElement<Derived>::BetweenOuter(const Derived& rhs) const {
+template <typename Derived, typename Element>
+Element GroupElement<Derived, Element>::BetweenOuter(const Element& rhs) const {
   return Compose(rhs.Inverse());
 }
 
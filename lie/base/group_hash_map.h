@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "lie/base/tangent_grid.h"
+
+namespace mana {
+
+// A hash map from Lie group elements to values, which treats elements within
+// `tolerance` (by `DistanceTo()`) of each other as the same key, e.g. to
+// deduplicate poses or headings, or to find a previously seen one, in O(1)
+// rather than by comparing against every element.
+//
+// Elements are hashed by their cell in a `TangentGrid` (see tangent_grid.h),
+// and a lookup probes the cells its near-duplicates may lie in, confirming
+// candidates by `DistanceTo()`. The table uses open addressing with linear
+// probing over a power-of-two array of (hash, entry) slots, kept at most half
+// full; the elements and values themselves are stored contiguously in
+// insertion order.
+template <typename Group, typename Value>
+class GroupHashMap {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Grid = TangentGrid<Group>;
+
+  // Construct an empty map, hashing by a grid of `resolution` (see
+  // `TangentGrid`), with `tolerance` at most half of every resolution.
+  GroupHashMap(const TangentVector& resolution, Scalar tolerance);
+
+  // Return the number of (distinct) elements.
+  size_t size() const;
+  bool empty() const;
+
+  // Reserve space for `size` elements, so that inserting up to that many
+  // does not rehash.
+  void reserve(size_t size);
+
+  // Remove all elements.
+  void clear();
+
+  // Return the value of the element nearest to `element` within the
+  // tolerance, or null if there is none.
+  const Value* Find(const Group& element) const;
+  Value* Find(const Group& element);
+
+  // Insert `element` with `value`, unless an element within the tolerance is
+  // already present. Returns the value of the (nearest) present element, or
+  // of the inserted one, and whether `element` was inserted. Pointers to
+  // values are invalidated by later insertions.
+  std::pair<Value*, bool> Insert(const Group& element, Value value);
+
+  // Access the distinct elements and their values, in insertion order.
+  const std::vector<Group>& elements() const;
+  const std::vector<Value>& values() const;
+
+ private:
+  static constexpr size_t kEmpty = std::numeric_limits<size_t>::max();
+
+  struct Slot {
+    uint64_t hash = 0;
+    size_t entry = kEmpty;
+  };
+
+  // Return the entry of the element nearest to `element` within the
+  // tolerance, or `kEmpty`, and set `hash` to the hash of its own cell.
+  size_t FindEntry(const Group& element, uint64_t& hash) const;
+
+  // Add a slot for `entry`, which must fit.
+  void AddSlot(uint64_t hash, size_t entry);
+
+  // Rebuild the slots with `capacity` (a power of two) slots.
+  void Rehash(size_t capacity);
+
+  Grid grid_;
+  Scalar tolerance_;
+  std::vector<Group> elements_;
+  std::vector<Value> values_;
+  std::vector<uint64_t> hashes_;
+  std::vector<Slot> slots_;
+};
+
+template <typename Group, typename Value>
+GroupHashMap<Group, Value>::GroupHashMap(const TangentVector& resolution,
+                                         Scalar tolerance)
+    : grid_(resolution), tolerance_(tolerance) {
+  assert(tolerance >= 0);
+  assert((2 * tolerance <= resolution.array()).all());
+}
+
+template <typename Group, typename Value>
+size_t GroupHashMap<Group, Value>::size() const {
+  return elements_.size();
+}
+
+template <typename Group, typename Value>
+bool GroupHashMap<Group, Value>::empty() const {
+  return size() == 0;
+}
+
+template <typename Group, typename Value>
+void GroupHashMap<Group, Value>::reserve(size_t size) {
+  elements_.reserve(size);
+  values_.reserve(size);
+  hashes_.reserve(size);
+  size_t capacity = 16;
+  while (capacity < 2 * size) capacity *= 2;
+  if (capacity > slots_.size()) Rehash(capacity);
+}
+
+template <typename Group, typename Value>
+void GroupHashMap<Group, Value>::clear() {
+  elements_.clear();
+  values_.clear();
+  hashes_.clear();
+  for (Slot& slot : slots_) slot.entry = kEmpty;
+}
+
+template <typename Group, typename Value>
+const Value* GroupHashMap<Group, Value>::Find(const Group& element) const {
+  uint64_t hash;
+  const size_t entry = FindEntry(element, hash);
+  return entry == kEmpty ? nullptr : &values_[entry];
+}
+
+template <typename Group, typename Value>
+Value* GroupHashMap<Group, Value>::Find(const Group& element) {
+  uint64_t hash;
+  const size_t entry = FindEntry(element, hash);
+  return entry == kEmpty ? nullptr : &values_[entry];
+}
+
+template <typename Group, typename Value>
+std::pair<Value*, bool> GroupHashMap<Group, Value>::Insert(
+    const Group& element, Value value) {
+  uint64_t hash;
+  const size_t entry = FindEntry(element, hash);
+  if (entry != kEmpty) return {&values_[entry], false};
+
+  if (2 * (size() + 1) > slots_.size()) {
+    Rehash(slots_.empty() ? 16 : 2 * slots_.size());
+  }
+  elements_.push_back(element);
+  values_.push_back(std::move(value));
+  hashes_.push_back(hash);
+  AddSlot(hash, size() - 1);
+  return {&values_.back(), true};
+}
+
+template <typename Group, typename Value>
+const std::vector<Group>& GroupHashMap<Group, Value>::elements() const {
+  return elements_;
+}
+
+template <typename Group, typename Value>
+const std::vector<Value>& GroupHashMap<Group, Value>::values() const {
+  return values_;
+}
+
+template <typename Group, typename Value>
+size_t GroupHashMap<Group, Value>::FindEntry(const Group& element,
+                                             uint64_t& hash) const {
+  size_t nearest = kEmpty;
+  Scalar nearest_distance = tolerance_;
+  bool own_cell = true;
+  grid_.ForEachCell(element, tolerance_, [&](const typename Grid::Cell& cell) {
+    const uint64_t cell_hash = Grid::Hash(cell);
+    // The first cell visited is the element's own.
+    if (own_cell) {
+      hash = cell_hash;
+      own_cell = false;
+    }
+    if (slots_.empty()) return;
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = cell_hash & mask; slots_[i].entry != kEmpty;
+         i = (i + 1) & mask) {
+      if (slots_[i].hash != cell_hash) continue;
+      const Scalar distance = element.DistanceTo(elements_[slots_[i].entry]);
+      if (distance <= nearest_distance) {
+        nearest = slots_[i].entry;
+        nearest_distance = distance;
+      }
+    }
+  });
+  return nearest;
+}
+
+template <typename Group, typename Value>
+void GroupHashMap<Group, Value>::AddSlot(uint64_t hash, size_t entry) {
+  const size_t mask = slots_.size() - 1;
+  size_t i = hash & mask;
+  while (slots_[i].entry != kEmpty) i = (i + 1) & mask;
+  slots_[i] = Slot{hash, entry};
+}
+
+template <typename Group, typename Value>
+void GroupHashMap<Group, Value>::Rehash(size_t capacity) {
+  assert((capacity & (capacity - 1)) == 0);
+  slots_.assign(capacity, Slot());
+  for (size_t entry = 0; entry < size(); ++entry) {
+    AddSlot(hashes_[entry], entry);
+  }
+}
+
+}  // namespace mana
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <limits>
 
 #include "lie/base/algebra_element.h"
+#include "lie/base/lie_group_traits.h"
 
 namespace mana {
 
@@ -30,13 +32,37 @@ class LieAlgebraElement : public AlgebraElement<Derived> {
   using AlgebraElement = typename LieAlgebraTraits<Derived>::AlgebraElement;
   using GroupElement = typename LieAlgebraTraits<Derived>::GroupElement;
   using Matrix = typename LieAlgebraTraits<Derived>::Matrix;
+  // A linear map on coordinate vectors.
+  using AdjointMatrix = Eigen::Matrix<Scalar, Dimension, Dimension>;
 
   // Return the matrix representation of this Lie algebra element.
   Matrix AsMatrix() const;
 
-  // The Lie bracket of this element and `rhs`.
+  // The Lie bracket of this element and `rhs`. Always zero for the Lie algebra
+  // of an abelian group.
   AlgebraElement Bracket(const AlgebraElement& rhs) const;
 
+  // Return the matrix of the adjoint map ad_a(b) = [a, b] of this element `a`,
+  // acting on coordinate vectors. Zero for the Lie algebra of an abelian group.
+  AdjointMatrix ad() const;
+
+  // Return the right Jacobian of the exponential map at this element,
+  //   Jr = sum_k (-ad)^k / (k + 1)!,
+  // summed until the remaining terms are negligible. Jr maps a perturbation of
+  // this element to the corresponding perturbation of its exponential, on the
+  // right: exp(a + da) ~= exp(a) exp(Jr da). The identity for the Lie algebra
+  // of an abelian group.
+  AdjointMatrix RightJacobian() const;
+
+  // Truncated Baker-Campbell-Hausdorff formula: approximate log(exp(a) exp(b))
+  // by its terms of degree at most `Order` (1 to 4) in `a` and `b`,
+  //   a + b + [a, b] / 2 + ([a, [a, b]] + [b, [b, a]]) / 12
+  //         - [b, [a, [a, b]]] / 24 + ...
+  // This lets many small increments be accumulated in the algebra, with a
+  // single `exp` at the end. Exact, at any order, for abelian groups.
+  template <int Order>
+  static AlgebraElement BCH(const AlgebraElement& a, const AlgebraElement& b);
+
   // Lower-case `log` map: construct a Lie algebra element from corresponding
   // Lie group element.
   static AlgebraElement log(const GroupElement& group);
@@ -47,7 +73,11 @@ class LieAlgebraElement : public AlgebraElement<Derived> {
 
   // Override base class's ComposeImpl method. (Matrix) Lie algebras have a well
   // defined composition available.
-  Matrix ComposeImpl(const AlgebraElement& rhs) const;
+  AlgebraElement ComposeImpl(const AlgebraElement& rhs) const;
+
+ protected:
+  // Construct from coordinate vector.
+  explicit LieAlgebraElement(Vector coordinates);
 
  private:
   // CRTP helpers.
@@ -64,7 +94,63 @@ LieAlgebraElement<Derived>::AsMatrix() const {
 template <typename Derived>
 typename LieAlgebraElement<Derived>::AlgebraElement
 LieAlgebraElement<Derived>::Bracket(const AlgebraElement& rhs) const {
-  return Compose(rhs) - rhs.Compose(derived());
+  if constexpr (IsAbelianLieGroup<GroupElement>::value) {
+    return AlgebraElement(Vector(Vector::Zero()));
+  } else {
+    return this->Compose(rhs) - rhs.Compose(derived());
+  }
+}
+
+template <typename Derived>
+typename LieAlgebraElement<Derived>::AdjointMatrix
+LieAlgebraElement<Derived>::ad() const {
+  AdjointMatrix adjoint = AdjointMatrix::Zero();
+  if constexpr (!IsAbelianLieGroup<GroupElement>::value) {
+    for (int j = 0; j < Dimension; ++j) {
+      adjoint.col(j) = Bracket(AlgebraElement::Hat(Vector::Unit(j))).Vee();
+    }
+  }
+  return adjoint;
+}
+
+template <typename Derived>
+typename LieAlgebraElement<Derived>::AdjointMatrix
+LieAlgebraElement<Derived>::RightJacobian() const {
+  AdjointMatrix jacobian = AdjointMatrix::Identity();
+  if constexpr (!IsAbelianLieGroup<GroupElement>::value) {
+    constexpr int kMaxTerms = 30;
+    const AdjointMatrix minus_ad = -ad();
+    AdjointMatrix term = AdjointMatrix::Identity();
+    for (int k = 1; k < kMaxTerms; ++k) {
+      term = term * minus_ad / (k + 1);
+      jacobian += term;
+      if (term.norm() <= std::numeric_limits<Scalar>::epsilon()) break;
+    }
+  }
+  return jacobian;
+}
+
+template <typename Derived>
+template <int Order>
+/*static*/ typename LieAlgebraElement<Derived>::AlgebraElement
+LieAlgebraElement<Derived>::BCH(const AlgebraElement& a,
+                                const AlgebraElement& b) {
+  static_assert(Order >= 1 && Order <= 4, "BCH is implemented up to order 4");
+  AlgebraElement result = a + b;
+  if constexpr (Order >= 2 && !IsAbelianLieGroup<GroupElement>::value) {
+    const AlgebraElement ab = a.Bracket(b);
+    result += ab / 2;
+    if constexpr (Order >= 3) {
+      // [b, [b, a]] = -[b, [a, b]].
+      const AlgebraElement a_ab = a.Bracket(ab);
+      const AlgebraElement b_ab = b.Bracket(ab);
+      result += (a_ab - b_ab) / 12;
+      if constexpr (Order >= 4) {
+        result -= b.Bracket(a_ab) / 24;
+      }
+    }
+  }
+  return result;
 }
 
 template <typename Derived>
@@ -80,9 +166,13 @@ LieAlgebraElement<Derived>::exp() const {
 }
 
 template <typename Derived>
-typename LieAlgebraElement<Derived>::Matrix
+typename LieAlgebraElement<Derived>::AlgebraElement
 LieAlgebraElement<Derived>::ComposeImpl(const AlgebraElement& rhs) const {
-  return AlgebraElement(AsMatrix() * rhs.AsMatrix());
+  return AlgebraElement(Matrix(AsMatrix() * rhs.AsMatrix()));
 }
 
+template <typename Derived>
+LieAlgebraElement<Derived>::LieAlgebraElement(Vector coordinates)
+    : mana::AlgebraElement<Derived>(std::move(coordinates)) {}
+
 }  // namespace mana
\ No newline at end of file
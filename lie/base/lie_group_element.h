@@ -2,19 +2,19 @@
 
 #include <Eigen/Dense>
 #include <cassert>
+#include <cstddef>
 #include <type_traits>
+#include <vector>
 
 #include "lie/base/algebra_element.h"
 #include "lie/base/group_element.h"
 #include "lie/base/lie_algebra_element.h"
+#include "lie/base/lie_group_traits.h"
 #include "lie/base/manifold_element.h"
+#include "lie/base/retraction.h"
 
 namespace mana {
 
-// Traits template for a Lie group.
-template <typename Derived>
-struct LieGroupTraits {};
-
 // Base CRTP class for an element of a Lie group. Lie group elements are
 // elements of both a group as well as a (differentiable, extrinsic) manifold.
 //
@@ -24,9 +24,21 @@ struct LieGroupTraits {};
 // - TangentVector LogImpl() const;
 // - static GroupElement ExpImpl(const TangentVector& coordinate);
 // - Jacobian AdjointImpl() const;
+// Derived classes may also provide faster (e.g. vectorized or closed-form)
+// versions of:
+// - static std::vector<GroupElement> ExpBatchImpl(
+//       const TangentBatch& coordinates);
+// - static GroupElement CayleyImpl(const TangentVector& coordinate);
+// - TangentVector InverseCayleyImpl() const;
+// - static GroupElement FirstOrderRetractImpl(const TangentVector& coordinate);
+// - TangentVector FirstOrderLocalImpl() const;
+// - static Jacobian RightJacobianImpl(const TangentVector& coordinate);
+// - static Jacobian RightJacobianInverseImpl(const TangentVector& coordinate);
 template <typename Derived>
-class LieGroupElement : public GroupElement<Derived>,
-                        public ManifoldElement<Derived> {
+class LieGroupElement
+    : public GroupElement<Derived,
+                          typename LieGroupTraits<Derived>::GroupElement>,
+      public ManifoldElement<Derived> {
  public:
   // Traits inherited from the fact that we are a manifold.
   using Scalar = typename ManifoldTraits<Derived>::Scalar;
@@ -42,12 +54,18 @@ class LieGroupElement : public GroupElement<Derived>,
   using GroupElement = typename LieGroupTraits<Derived>::GroupElement;
   using AlgebraElement = typename LieGroupTraits<Derived>::AlgebraElement;
   using Jacobian = typename LieGroupTraits<Derived>::Jacobian;
+  // A batch of tangent vectors, stored column-wise.
+  using TangentBatch = Eigen::Matrix<Scalar, Dimension, Eigen::Dynamic>;
+  // Whether composition commutes (see `IsAbelianLieGroup<>`). Abelian groups
+  // take shortcuts: their adjoint is the identity, and left- and right- plus
+  // and minus coincide.
+  static constexpr bool IsAbelian = IsAbelianLieGroup<Derived>::value;
 
   // Trait checks: Ensure this Lie group is compatible with the associated
   // algebra type.
-  static_assert(std::is_same_v<AlgebraElement::Scalar, Scalar>);
-  static_assert(std::is_same_v<AlgebraElement::Vector, TangentVector>);
-  static_assert(std::is_same_v<AlgebraElement::Dimension, Dimension>);
+  static_assert(std::is_same_v<typename AlgebraElement::Scalar, Scalar>);
+  static_assert(std::is_same_v<typename AlgebraElement::Vector, TangentVector>);
+  static_assert(AlgebraElement::Dimension == Dimension);
 
   // Lower-case `log` map: return the Lie algebra element for this Lie group
   // element.
@@ -65,11 +83,26 @@ class LieGroupElement : public GroupElement<Derived>,
   // algebra coordinate vector.
   static GroupElement Exp(const TangentVector& coordinate);
 
+  // Batched `Exp` map: construct one Lie group element per column of
+  // `coordinates`.
+  static std::vector<GroupElement> ExpBatch(const TangentBatch& coordinates);
+
   // Return the adjoint of this Lie group element. The adjoint is a square
   // matrix that maps coordinate vectors from the tangent space of this group
   // element to the Lie algebra (the tangent space at the identity element).
+  // The adjoint of an abelian group is the identity.
   Jacobian Adjoint() const;
 
+  // The right and left Jacobians of `Exp` at `coordinate`, and their inverses
+  // (see Eqs. 41-46 in A micro Lie theory for state estimation in robotics):
+  //   Exp(tau + dtau) ~= Exp(tau) Exp(Jr(tau) dtau)
+  //                   ~= Exp(Jl(tau) dtau) Exp(tau),
+  // with Jl(tau) = Jr(-tau). All are the identity for an abelian group.
+  static Jacobian RightJacobian(const TangentVector& coordinate);
+  static Jacobian LeftJacobian(const TangentVector& coordinate);
+  static Jacobian RightJacobianInverse(const TangentVector& coordinate);
+  static Jacobian LeftJacobianInverse(const TangentVector& coordinate);
+
   // The (lower-case versions of) right- and left- plus and minus operators (see
   // Eqs. 25-28 in A micro Lie theory for state estimation in robotics). These
   // functions operate on / return Lie algebra elements (not tangent vectors).
@@ -84,12 +117,16 @@ class LieGroupElement : public GroupElement<Derived>,
   // The (upper-case versions of) right- and left- plus and minus operators (see
   // Eqs. 25-28 in A micro Lie theory for state estimation in robotics). These
   // functions operate on / return tangent vectors in the Lie algebra. The
-  // `Plus` and `Minus` methods default to right-plus and right-minus.
+  // `Plus` and `Minus` methods default to right-plus and right-minus, and
+  // optionally replace Exp and Log with a cheaper `Retraction` (see
+  // retraction.h).
   GroupElement Rplus(const TangentVector& rhs) const;
   GroupElement Lplus(const TangentVector& lhs) const;
+  template <typename Retraction = ExpRetraction>
   GroupElement Plus(const TangentVector& rhs) const;
   TangentVector Rminus(const GroupElement& rhs) const;
   TangentVector Lminus(const GroupElement& rhs) const;
+  template <typename Retraction = ExpRetraction>
   TangentVector Minus(const GroupElement& rhs) const;
 
   // Override base class's DistanceToImpl and InterpolateImpl methods. Lie
@@ -97,12 +134,109 @@ class LieGroupElement : public GroupElement<Derived>,
   Scalar DistanceToImpl(const GroupElement& rhs) const;
   GroupElement InterpolateImpl(const GroupElement& rhs, Scalar fraction) const;
 
+  // Default implementation of `ExpBatch`, one `Exp` per column.
+  static std::vector<GroupElement> ExpBatchImpl(
+      const TangentBatch& coordinates);
+
+  // Default implementations of the `CayleyRetraction` and
+  // `FirstOrderRetraction` hooks, using the group's matrix representation.
+  // These require the embedding space to be the space of the Lie algebra's
+  // matrices. The default first-order local map exactly inverts the
+  // first-order retraction when `Project()` is the orthogonal polar
+  // projection and the algebra is skew-symmetric, as for SO(n); other groups
+  // must provide their own.
+  static GroupElement CayleyImpl(const TangentVector& coordinate);
+  TangentVector InverseCayleyImpl() const;
+  static GroupElement FirstOrderRetractImpl(const TangentVector& coordinate);
+  TangentVector FirstOrderLocalImpl() const;
+
+  // Default implementations of the right Jacobian and its inverse, summing
+  // the series in the algebra's `ad` (see `LieAlgebraElement::RightJacobian`)
+  // and inverting it.
+  static Jacobian RightJacobianImpl(const TangentVector& coordinate);
+  static Jacobian RightJacobianInverseImpl(const TangentVector& coordinate);
+
  private:
   // CRTP helpers.
   Derived& derived() { return static_cast<Derived&>(*this); }
   const Derived& derived() const { return static_cast<const Derived&>(*this); }
 };
 
+// Chart on a Lie group centered at `origin`, mapping X to Log(origin^{-1} * X)
+// and back with origin * Exp(xi). The origin's inverse is computed once at
+// construction, so each mapping costs a single composition plus a Log or Exp.
+template <typename Derived>
+class LieGroupChart : public ManifoldChart<Derived> {
+ public:
+  using Element = typename ManifoldTraits<Derived>::Element;
+  using TangentVector = typename ManifoldTraits<Derived>::TangentVector;
+  using TangentBatch = typename LieGroupElement<Derived>::TangentBatch;
+
+  // Construct from origin point on the Lie group.
+  explicit LieGroupChart(Element origin);
+
+  // Map an element of the Lie group to the tangent space at the origin,
+  // i.e. origin.Rminus(rhs).
+  TangentVector ToTangent(const Element& rhs) const;
+
+  // Map a tangent vector at the origin to an element of the Lie group, i.e.
+  // origin.Rplus(rhs).
+  Element ToManifold(const TangentVector& rhs) const;
+
+  // Batched versions of the above, mapping many elements through this chart.
+  // Tangent vectors are stored column-wise.
+  TangentBatch ToTangent(const std::vector<Element>& elements) const;
+  std::vector<Element> ToManifold(const TangentBatch& coordinates) const;
+
+ private:
+  // The inverse of the chart's origin.
+  Element origin_inverse_;
+};
+
+// Geodesic between two elements of a Lie group, following the one-parameter
+// subgroup X(f) = beg * Exp(f * xi), where xi = Log(beg^{-1} * end). The
+// tangent xi is computed once at construction, so interpolating costs one Exp
+// and one composition.
+template <typename Derived>
+class LieGroupGeodesic : public ManifoldGeodesic<Derived> {
+ public:
+  using Scalar = typename ManifoldTraits<Derived>::Scalar;
+  using Element = typename ManifoldTraits<Derived>::Element;
+  using TangentVector = typename ManifoldTraits<Derived>::TangentVector;
+  using TangentBatch = typename LieGroupElement<Derived>::TangentBatch;
+
+  // Construct from start and end points.
+  LieGroupGeodesic(Element beg, Element end);
+
+  // Return the geodesic's tangent, xi = Log(beg^{-1} * end).
+  const TangentVector& Tangent() const;
+
+  // Interpolate along the geodesic at the provided fraction. Values in [0, 1]
+  // perform true interpolation, values outside of this range perform
+  // extrapolation.
+  Element Interpolate(Scalar fraction) const;
+
+  // Interpolate along the geodesic at each of the provided fractions, with a
+  // single batched (see `LieGroupElement::ExpBatch`) Exp.
+  std::vector<Element> Interpolate(const std::vector<Scalar>& fractions) const;
+
+  // Return the length of this geodesic.
+  Scalar Length() const;
+
+  // Sample `n` points along the geodesic at fractions beg_fraction,
+  // beg_fraction + step, ..., beg_fraction + (n - 1) * step. The geodesic has
+  // a constant twist, so consecutive samples satisfy
+  //   X(f + step) = X(f) * Exp(step * xi),
+  // and all but every `kRecurrenceResyncPeriod`-th sample cost a single
+  // composition instead of an Exp.
+  std::vector<Element> SampleUniform(Scalar beg_fraction, Scalar step,
+                                     size_t n) const;
+
+ private:
+  // The geodesic's tangent, Log(beg^{-1} * end).
+  TangentVector tangent_;
+};
+
 template <typename Derived>
 typename LieGroupElement<Derived>::AlgebraElement
 LieGroupElement<Derived>::log() const {
@@ -124,13 +258,57 @@ LieGroupElement<Derived>::exp(const AlgebraElement& algebra) {
 template <typename Derived>
 /*static*/ typename LieGroupElement<Derived>::GroupElement
 LieGroupElement<Derived>::Exp(const TangentVector& coordinate) {
-  return derived().ExpImpl(coordinate);
+  return Derived::ExpImpl(coordinate);
+}
+
+template <typename Derived>
+/*static*/ std::vector<typename LieGroupElement<Derived>::GroupElement>
+LieGroupElement<Derived>::ExpBatch(const TangentBatch& coordinates) {
+  return Derived::ExpBatchImpl(coordinates);
 }
 
 template <typename Derived>
 typename LieGroupElement<Derived>::Jacobian LieGroupElement<Derived>::Adjoint()
     const {
-  return derived().AdjointImpl();
+  if constexpr (IsAbelian) {
+    return Jacobian::Identity();
+  } else {
+    return derived().AdjointImpl();
+  }
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::RightJacobian(const TangentVector& coordinate) {
+  if constexpr (IsAbelian) {
+    return Jacobian::Identity();
+  } else {
+    return Derived::RightJacobianImpl(coordinate);
+  }
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::LeftJacobian(const TangentVector& coordinate) {
+  return RightJacobian(-coordinate);
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::RightJacobianInverse(
+    const TangentVector& coordinate) {
+  if constexpr (IsAbelian) {
+    return Jacobian::Identity();
+  } else {
+    return Derived::RightJacobianInverseImpl(coordinate);
+  }
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::LeftJacobianInverse(
+    const TangentVector& coordinate) {
+  return RightJacobianInverse(-coordinate);
 }
 
 template <typename Derived>
@@ -154,13 +332,17 @@ typename LieGroupElement<Derived>::GroupElement LieGroupElement<Derived>::plus(
 template <typename Derived>
 typename LieGroupElement<Derived>::AlgebraElement
 LieGroupElement<Derived>::rminus(const GroupElement& rhs) const {
-  return BetweenInner(rhs).log();
+  return this->BetweenInner(rhs).log();
 }
 
 template <typename Derived>
 typename LieGroupElement<Derived>::AlgebraElement
 LieGroupElement<Derived>::lminus(const GroupElement& rhs) const {
-  return rhs.BetweenOuter(*this).log();
+  if constexpr (IsAbelian) {
+    return rminus(rhs);
+  } else {
+    return rhs.BetweenOuter(derived()).log();
+  }
 }
 
 template <typename Derived>
@@ -172,19 +354,24 @@ LieGroupElement<Derived>::minus(const GroupElement& rhs) const {
 template <typename Derived>
 typename LieGroupElement<Derived>::GroupElement LieGroupElement<Derived>::Rplus(
     const TangentVector& rhs) const {
-  return Compose(Exp(rhs));
+  return this->Compose(Exp(rhs));
 }
 
 template <typename Derived>
 typename LieGroupElement<Derived>::GroupElement LieGroupElement<Derived>::Lplus(
     const TangentVector& lhs) const {
-  return Exp(lhs).Compose(*this);
+  if constexpr (IsAbelian) {
+    return Rplus(lhs);
+  } else {
+    return Exp(lhs).Compose(derived());
+  }
 }
 
 template <typename Derived>
+template <typename Retraction>
 typename LieGroupElement<Derived>::GroupElement LieGroupElement<Derived>::Plus(
     const TangentVector& rhs) const {
-  return Rplus(rhs);
+  return this->Compose(Retraction::template Retract<GroupElement>(rhs));
 }
 
 template <typename Derived>
@@ -200,22 +387,190 @@ LieGroupElement<Derived>::Lminus(const GroupElement& rhs) const {
 }
 
 template <typename Derived>
+template <typename Retraction>
 typename LieGroupElement<Derived>::TangentVector
 LieGroupElement<Derived>::Minus(const GroupElement& rhs) const {
-  return minus(rhs).Vee();
+  return Retraction::template Local<GroupElement>(this->BetweenInner(rhs));
 }
 
 template <typename Derived>
 typename LieGroupElement<Derived>::Scalar
 LieGroupElement<Derived>::DistanceToImpl(const GroupElement& rhs) const {
-  return Minus().norm();
+  return Minus(rhs).norm();
 }
 
 template <typename Derived>
 typename LieGroupElement<Derived>::GroupElement
 LieGroupElement<Derived>::InterpolateImpl(const GroupElement& rhs,
                                           Scalar fraction) const {
-  return Plus(fraction * rhs.Log());
+  return Plus(fraction * Minus(rhs));
+}
+
+template <typename Derived>
+/*static*/ std::vector<typename LieGroupElement<Derived>::GroupElement>
+LieGroupElement<Derived>::ExpBatchImpl(const TangentBatch& coordinates) {
+  std::vector<GroupElement> elements;
+  elements.reserve(coordinates.cols());
+  for (Eigen::Index i = 0; i < coordinates.cols(); ++i) {
+    elements.push_back(Exp(coordinates.col(i)));
+  }
+  return elements;
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::GroupElement
+LieGroupElement<Derived>::CayleyImpl(const TangentVector& coordinate) {
+  using Matrix = typename AlgebraElement::Matrix;
+  static_assert(std::is_same_v<Matrix, EmbeddingPoint>);
+  const Matrix half = AlgebraElement::Hat(coordinate).AsMatrix() / 2;
+  const Matrix identity = Matrix::Identity();
+  return Derived::FromPoint(
+      (identity - half).partialPivLu().solve(identity + half));
+}
+
+template <typename Derived>
+typename LieGroupElement<Derived>::TangentVector
+LieGroupElement<Derived>::InverseCayleyImpl() const {
+  using Matrix = typename AlgebraElement::Matrix;
+  static_assert(std::is_same_v<Matrix, EmbeddingPoint>);
+  const Matrix point = this->Point();
+  const Matrix identity = Matrix::Identity();
+  // (X + I) and (X - I) commute, so the order of the product is immaterial.
+  const Matrix algebra =
+      2 * (point + identity).partialPivLu().solve(point - identity);
+  return AlgebraElement(algebra).Vee();
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::GroupElement
+LieGroupElement<Derived>::FirstOrderRetractImpl(
+    const TangentVector& coordinate) {
+  using Matrix = typename AlgebraElement::Matrix;
+  static_assert(std::is_same_v<Matrix, EmbeddingPoint>);
+  const Matrix point =
+      Matrix::Identity() + AlgebraElement::Hat(coordinate).AsMatrix();
+  return Derived::FromPoint(Derived::Project(point));
+}
+
+template <typename Derived>
+typename LieGroupElement<Derived>::TangentVector
+LieGroupElement<Derived>::FirstOrderLocalImpl() const {
+  using Matrix = typename AlgebraElement::Matrix;
+  static_assert(std::is_same_v<Matrix, EmbeddingPoint>);
+  // For X = Project(I + A) = (I + A) (I - A^2)^{-1/2}, the polar factor of
+  // I + A with A skew, X - X^T = 2 A S and X + X^T = 2 S, where
+  // S = (I - A^2)^{-1/2} commutes with A. So A = (X + X^T)^{-1} (X - X^T).
+  const Matrix point = this->Point();
+  const Matrix algebra = (point + point.transpose())
+                             .partialPivLu()
+                             .solve(point - point.transpose());
+  return AlgebraElement(algebra).Vee();
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::RightJacobianImpl(const TangentVector& coordinate) {
+  return Jacobian(AlgebraElement::Hat(coordinate).RightJacobian());
+}
+
+template <typename Derived>
+/*static*/ typename LieGroupElement<Derived>::Jacobian
+LieGroupElement<Derived>::RightJacobianInverseImpl(
+    const TangentVector& coordinate) {
+  return Jacobian(RightJacobian(coordinate).inverse());
+}
+
+template <typename Derived>
+LieGroupChart<Derived>::LieGroupChart(Element origin)
+    : ManifoldChart<Derived>(std::move(origin)),
+      origin_inverse_(this->origin().Inverse()) {}
+
+template <typename Derived>
+typename LieGroupChart<Derived>::TangentVector
+LieGroupChart<Derived>::ToTangent(const Element& rhs) const {
+  return origin_inverse_.Compose(rhs).Log();
+}
+
+template <typename Derived>
+typename LieGroupChart<Derived>::Element LieGroupChart<Derived>::ToManifold(
+    const TangentVector& rhs) const {
+  return this->origin().Compose(Element::Exp(rhs));
+}
+
+template <typename Derived>
+typename LieGroupChart<Derived>::TangentBatch LieGroupChart<Derived>::ToTangent(
+    const std::vector<Element>& elements) const {
+  TangentBatch coordinates(TangentBatch::RowsAtCompileTime, elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    coordinates.col(i) = ToTangent(elements[i]);
+  }
+  return coordinates;
+}
+
+template <typename Derived>
+std::vector<typename LieGroupChart<Derived>::Element>
+LieGroupChart<Derived>::ToManifold(const TangentBatch& coordinates) const {
+  std::vector<Element> elements = Element::ExpBatch(coordinates);
+  for (Element& element : elements) {
+    element = this->origin().Compose(element);
+  }
+  return elements;
+}
+
+template <typename Derived>
+LieGroupGeodesic<Derived>::LieGroupGeodesic(Element beg, Element end)
+    : ManifoldGeodesic<Derived>(std::move(beg), std::move(end)),
+      tangent_(this->beg().Rminus(this->end())) {}
+
+template <typename Derived>
+const typename LieGroupGeodesic<Derived>::TangentVector&
+LieGroupGeodesic<Derived>::Tangent() const {
+  return tangent_;
+}
+
+template <typename Derived>
+typename LieGroupGeodesic<Derived>::Element
+LieGroupGeodesic<Derived>::Interpolate(Scalar fraction) const {
+  return this->beg().Rplus(fraction * tangent_);
+}
+
+template <typename Derived>
+std::vector<typename LieGroupGeodesic<Derived>::Element>
+LieGroupGeodesic<Derived>::Interpolate(
+    const std::vector<Scalar>& fractions) const {
+  const Eigen::Map<const Eigen::Matrix<Scalar, 1, Eigen::Dynamic>> row(
+      fractions.data(), fractions.size());
+  const TangentBatch coordinates = tangent_ * row;
+  std::vector<Element> points = Element::ExpBatch(coordinates);
+  for (Element& point : points) {
+    point = this->beg().Compose(point);
+  }
+  return points;
+}
+
+template <typename Derived>
+typename LieGroupGeodesic<Derived>::Scalar LieGroupGeodesic<Derived>::Length()
+    const {
+  return tangent_.norm();
+}
+
+template <typename Derived>
+std::vector<typename LieGroupGeodesic<Derived>::Element>
+LieGroupGeodesic<Derived>::SampleUniform(Scalar beg_fraction, Scalar step,
+                                         size_t n) const {
+  const Element& beg = this->beg();
+  const TangentVector& tangent = tangent_;
+  const Element increment = Element::Exp(step * tangent);
+  std::vector<Element> samples;
+  samples.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    if (i % kRecurrenceResyncPeriod == 0) {
+      samples.push_back(beg.Rplus((beg_fraction + i * step) * tangent));
+    } else {
+      samples.push_back(samples.back().Compose(increment));
+    }
+  }
+  return samples;
 }
 
 }  // namespace mana
\ No newline at end of file
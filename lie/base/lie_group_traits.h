@@ -0,0 +1,23 @@
+#pragma once
+
+#include <type_traits>
+
+namespace mana {
+
+// Traits template for a Lie group.
+template <typename Derived>
+struct LieGroupTraits {};
+
+// Whether the Lie group `Derived` is abelian, i.e. whether its composition
+// commutes (e.g. SO2, or R^n under addition). Groups opt in by declaring
+// `static constexpr bool IsAbelian = true;` in their `LieGroupTraits<>`
+// specialization; all other groups are treated as non-abelian.
+template <typename Derived, typename = void>
+struct IsAbelianLieGroup : std::false_type {};
+
+template <typename Derived>
+struct IsAbelianLieGroup<
+    Derived, std::void_t<decltype(LieGroupTraits<Derived>::IsAbelian)>>
+    : std::bool_constant<LieGroupTraits<Derived>::IsAbelian> {};
+
+}  // namespace mana
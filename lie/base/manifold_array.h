@@ -0,0 +1,227 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "lie/base/array_kernels.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+// A fixed-size array of manifold elements stored in structure-of-arrays form:
+// storage coordinate k of every element is contiguous in row k of `storage()`.
+// Vectorized kernels can then stream over one coordinate at a time, and the
+// algorithms below (Transform, Compose, Log, Reduce) process the array in
+// parallel, in chunks, under an execution policy (see utils/parallel.h).
+//
+// `T` must provide:
+// - static constexpr int StorageDimension;
+// - static T FromStorage(const Scalar* storage);
+// - void ToStorage(Scalar* storage) const;
+template <typename T>
+class ManifoldArray {
+ public:
+  using Element = T;
+  using Scalar = typename T::Scalar;
+  static constexpr int StorageDimension = T::StorageDimension;
+  using Storage =
+      Eigen::Matrix<Scalar, StorageDimension, Eigen::Dynamic, Eigen::RowMajor>;
+
+  // Construct an array of `size` copies of `value`.
+  explicit ManifoldArray(size_t size = 0, const T& value = T());
+
+  // Construct from a vector of elements.
+  explicit ManifoldArray(const std::vector<T>& elements);
+
+  // Return the number of elements.
+  size_t size() const;
+  bool empty() const;
+
+  // Read (a copy of) the element at `index`.
+  T operator[](size_t index) const;
+
+  // Overwrite the element at `index`.
+  void Set(size_t index, const T& value);
+
+  // Copy all elements out to a vector.
+  std::vector<T> ToVector() const;
+
+  // Access the underlying structure-of-arrays storage.
+  const Storage& storage() const;
+  Storage& storage();
+
+ private:
+  Storage storage_;
+};
+
+// Set output[i] = fn(input[i]) for all i. `output` must have the same size as
+// `input`, and may hold a different element type.
+template <typename Policy, typename T, typename U, typename Fn>
+void Transform(const Policy& policy, const ManifoldArray<T>& input,
+               ManifoldArray<U>& output, Fn&& fn);
+
+// Set output[i] = lhs[i] * rhs[i] for all i, with the chunk kernel of
+// `ArrayKernels<T>` (see array_kernels.h). All arrays must have the same size;
+// `output` may alias `lhs` or `rhs`.
+template <typename Policy, typename T>
+void Compose(const Policy& policy, const ManifoldArray<T>& lhs,
+             const ManifoldArray<T>& rhs, ManifoldArray<T>& output);
+
+// Return the Log of every element (of a Lie group), stored column-wise.
+template <typename Policy, typename T>
+typename T::TangentBatch Log(const Policy& policy,
+                             const ManifoldArray<T>& array);
+
+// Return the array {array[indices[0]], array[indices[1]], ...}, e.g. the
+// survivors of particle filter resampling. Copies storage row by row.
+template <typename Policy, typename T>
+ManifoldArray<T> Gather(const Policy& policy, const ManifoldArray<T>& array,
+                        const std::vector<size_t>& indices);
+
+// As above, writing to `output`, which must have the same size as `indices`
+// and must not alias `array`.
+template <typename Policy, typename T>
+void Gather(const Policy& policy, const ManifoldArray<T>& array,
+            const std::vector<size_t>& indices, ManifoldArray<T>& output);
+
+// Return op(...op(op(init, array[0]), array[1])..., array[n - 1]), evaluated
+// as a deterministic parallel reduction (see `ParallelReduce()`), so `op` need
+// only be associative. For example, with `op` as composition, this is the
+// product of all elements in order.
+template <typename Policy, typename T, typename Op>
+T Reduce(const Policy& policy, const ManifoldArray<T>& array, T init, Op&& op);
+
+template <typename T>
+ManifoldArray<T>::ManifoldArray(size_t size, const T& value)
+    : storage_(StorageDimension, size) {
+  Eigen::Matrix<Scalar, StorageDimension, 1> coordinates;
+  value.ToStorage(coordinates.data());
+  storage_.colwise() = coordinates;
+}
+
+template <typename T>
+ManifoldArray<T>::ManifoldArray(const std::vector<T>& elements)
+    : storage_(StorageDimension, elements.size()) {
+  for (size_t i = 0; i < elements.size(); ++i) Set(i, elements[i]);
+}
+
+template <typename T>
+size_t ManifoldArray<T>::size() const {
+  return storage_.cols();
+}
+
+template <typename T>
+bool ManifoldArray<T>::empty() const {
+  return size() == 0;
+}
+
+template <typename T>
+T ManifoldArray<T>::operator[](size_t index) const {
+  assert(index < size());
+  Scalar coordinates[StorageDimension];
+  for (int k = 0; k < StorageDimension; ++k) {
+    coordinates[k] = storage_(k, index);
+  }
+  return T::FromStorage(coordinates);
+}
+
+template <typename T>
+void ManifoldArray<T>::Set(size_t index, const T& value) {
+  assert(index < size());
+  Scalar coordinates[StorageDimension];
+  value.ToStorage(coordinates);
+  for (int k = 0; k < StorageDimension; ++k) {
+    storage_(k, index) = coordinates[k];
+  }
+}
+
+template <typename T>
+std::vector<T> ManifoldArray<T>::ToVector() const {
+  std::vector<T> elements;
+  elements.reserve(size());
+  for (size_t i = 0; i < size(); ++i) elements.push_back((*this)[i]);
+  return elements;
+}
+
+template <typename T>
+const typename ManifoldArray<T>::Storage& ManifoldArray<T>::storage() const {
+  return storage_;
+}
+
+template <typename T>
+typename ManifoldArray<T>::Storage& ManifoldArray<T>::storage() {
+  return storage_;
+}
+
+template <typename Policy, typename T, typename U, typename Fn>
+void Transform(const Policy& policy, const ManifoldArray<T>& input,
+               ManifoldArray<U>& output, Fn&& fn) {
+  assert(output.size() == input.size());
+  ParallelFor(policy, input.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) output.Set(i, fn(input[i]));
+  });
+}
+
+template <typename Policy, typename T>
+void Compose(const Policy& policy, const ManifoldArray<T>& lhs,
+             const ManifoldArray<T>& rhs, ManifoldArray<T>& output) {
+  assert(lhs.size() == rhs.size());
+  assert(output.size() == lhs.size());
+  ParallelFor(policy, lhs.size(), [&](size_t begin, size_t end) {
+    ArrayKernels<T>::Compose(lhs.storage(), rhs.storage(), begin, end,
+                             output.storage());
+  });
+}
+
+template <typename Policy, typename T>
+typename T::TangentBatch Log(const Policy& policy,
+                             const ManifoldArray<T>& array) {
+  typename T::TangentBatch coordinates(T::Dimension, array.size());
+  ParallelFor(policy, array.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) coordinates.col(i) = array[i].Log();
+  });
+  return coordinates;
+}
+
+template <typename Policy, typename T>
+ManifoldArray<T> Gather(const Policy& policy, const ManifoldArray<T>& array,
+                        const std::vector<size_t>& indices) {
+  ManifoldArray<T> gathered(indices.size());
+  Gather(policy, array, indices, gathered);
+  return gathered;
+}
+
+template <typename Policy, typename T>
+void Gather(const Policy& policy, const ManifoldArray<T>& array,
+            const std::vector<size_t>& indices, ManifoldArray<T>& output) {
+  assert(output.size() == indices.size());
+  assert(&output != &array);
+  ParallelFor(policy, indices.size(), [&](size_t begin, size_t end) {
+    for (int k = 0; k < T::StorageDimension; ++k) {
+      for (size_t j = begin; j < end; ++j) {
+        assert(indices[j] < array.size());
+        output.storage()(k, j) = array.storage()(k, indices[j]);
+      }
+    }
+  });
+}
+
+template <typename Policy, typename T, typename Op>
+T Reduce(const Policy& policy, const ManifoldArray<T>& array, T init,
+         Op&& op) {
+  return ParallelReduce(
+      policy, array.size(), std::move(init),
+      [&](size_t begin, size_t end) {
+        T partial = array[begin];
+        for (size_t i = begin + 1; i < end; ++i) {
+          partial = op(partial, array[i]);
+        }
+        return partial;
+      },
+      op);
+}
+
+}  // namespace mana
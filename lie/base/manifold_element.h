@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 #include "lie/base/constants.h"
 
@@ -62,10 +64,10 @@ class ManifoldElement {
   // Return this element's point in the underlying embedding space.
   EmbeddingPoint Point() const;
 
-#if 0
   // Build a chart at this point on the manifold.
-  Chart LocalChart() const { return Chart(*this); }
+  Chart LocalChart() const;
 
+#if 0
   // Returns a basis for the tangent space at this point on the manifold.
   std::array<TangentVector, Dimension> TangentSpaceBasis() const {
     return derived().TangentSpaceBasisImpl();
@@ -101,6 +103,12 @@ class ManifoldElement {
 
 // Class representing a chart on a manifold, mapping from the manifold to its
 // tangent space.
+//
+// This base only holds the chart's origin. The forward and reverse maps,
+// `ToTangent()` and `ToManifold()`, depend on the manifold's structure, and
+// are provided by derived charts: see `LieGroupChart` (lie_group_element.h)
+// for Lie groups. There is no generic map for bare manifolds, so calling them
+// through this base does not compile.
 template <typename Derived>
 class ManifoldChart {
  public:
@@ -110,13 +118,8 @@ class ManifoldChart {
   // Construct from origin point on the manifold.
   explicit ManifoldChart(Element origin);
 
-  // Map an element on the manifold to a tangent vector using the chart's
-  // forward map.
-  TangentVector ToTangent(const Element& rhs) const;
-
-  // Map a tangent vector to an element on the manifold using the chart's
-  // reverse map.
-  Element ToManifold(const TangentVector& rhs) const;
+  // Return the chart's origin.
+  const Element& origin() const;
 
  private:
   // The point forming the origin of this chart. The zero tangent vector is
@@ -144,6 +147,14 @@ class ManifoldGeodesic {
   // extrapolation.
   Element Interpolate(Scalar fraction) const;
 
+  // Interpolate along the geodesic at each of the provided fractions.
+  std::vector<Element> Interpolate(const std::vector<Scalar>& fractions) const;
+
+  // Sample `n` points along the geodesic at fractions beg_fraction,
+  // beg_fraction + step, ..., beg_fraction + (n - 1) * step.
+  std::vector<Element> SampleUniform(Scalar beg_fraction, Scalar step,
+                                     size_t n) const;
+
   // Return the length of this geodesic.
   Scalar Length() const;
 
@@ -176,6 +187,12 @@ ManifoldElement<Derived>::Point() const {
   return derived().PointImpl();
 }
 
+template <typename Derived>
+typename ManifoldElement<Derived>::Chart ManifoldElement<Derived>::LocalChart()
+    const {
+  return Chart(derived());
+}
+
 template <typename Derived>
 typename ManifoldElement<Derived>::Geodesic
 ManifoldElement<Derived>::GeodesicTo(const Element& rhs) const {
@@ -216,17 +233,9 @@ ManifoldChart<Derived>::ManifoldChart(Element origin)
     : origin_(std::move(origin)) {}
 
 template <typename Derived>
-typename ManifoldChart<Derived>::TangentVector
-ManifoldChart<Derived>::ToTangent(const Element& rhs) const {
-  // TODO(erik): implement.
-  return {};
-}
-
-template <typename Derived>
-typename ManifoldChart<Derived>::Element ManifoldChart<Derived>::ToManifold(
-    const TangentVector& rhs) const {
-  // TODO(erik): implement.
-  return {};
+const typename ManifoldChart<Derived>::Element& ManifoldChart<Derived>::origin()
+    const {
+  return origin_;
 }
 
 template <typename Derived>
@@ -251,6 +260,30 @@ ManifoldGeodesic<Derived>::Interpolate(Scalar fraction) const {
   return beg_.Interpolate(end_, fraction);
 }
 
+template <typename Derived>
+std::vector<typename ManifoldGeodesic<Derived>::Element>
+ManifoldGeodesic<Derived>::Interpolate(
+    const std::vector<Scalar>& fractions) const {
+  std::vector<Element> points;
+  points.reserve(fractions.size());
+  for (const Scalar fraction : fractions) {
+    points.push_back(Interpolate(fraction));
+  }
+  return points;
+}
+
+template <typename Derived>
+std::vector<typename ManifoldGeodesic<Derived>::Element>
+ManifoldGeodesic<Derived>::SampleUniform(Scalar beg_fraction, Scalar step,
+                                         size_t n) const {
+  std::vector<Element> samples;
+  samples.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    samples.push_back(Interpolate(beg_fraction + i * step));
+  }
+  return samples;
+}
+
 template <typename Derived>
 typename ManifoldGeodesic<Derived>::Scalar ManifoldGeodesic<Derived>::Length()
     const {
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "lie/base/lie_group_element.h"
+
+namespace mana {
+
+template <typename Group>
+class Map;
+
+// A `Map` shares the traits of the group it views, so the group operations of
+// a `Map<Group>` (and of a `Map<const Group>`) return owning `Group`s.
+template <typename Group>
+struct ManifoldTraits<Map<Group>> : ManifoldTraits<std::remove_const_t<Group>> {
+};
+
+template <typename Group>
+struct LieGroupTraits<Map<Group>> : LieGroupTraits<std::remove_const_t<Group>> {
+};
+
+// A view of a Lie group element stored in external memory, e.g. a sensor
+// buffer of packed rotations, in the layout of the group's `ToStorage()`. A
+// `Map` implements the full `LieGroupElement` interface over that memory, so
+// a buffer can be used without first converting it into a vector of `Group`s.
+// A `Map<Group>` may also be assigned to, writing through to the viewed
+// memory, while a `Map<const Group>` is read-only. Like a pointer, a `Map`
+// does not own the memory it views, which must outlive it.
+//
+// A `Map` is not free to operate on: each operation (`Compose()`,
+// `Inverse()`, `Log()`, `Point()`, ...) first rebuilds an owning `Group` from
+// the viewed storage with `FromStorage()`, i.e. copies its
+// `StorageDimension` scalars, and then forwards to it. What it saves is the
+// up-front copy of the whole buffer, and the memory for it.
+//
+// `Group` must provide:
+// - static constexpr int StorageDimension;
+// - static Group FromStorage(const Scalar* storage);
+// - void ToStorage(Scalar* storage) const;
+template <typename Group>
+class Map : public LieGroupElement<Map<Group>> {
+  using Base = LieGroupElement<Map<Group>>;
+
+ public:
+  // Trait typedefs.
+  using Scalar = typename Base::Scalar;
+  using TangentVector = typename Base::TangentVector;
+  using TangentBatch = typename Base::TangentBatch;
+  using EmbeddingPoint = typename Base::EmbeddingPoint;
+  using GroupElement = typename Base::GroupElement;
+  using Jacobian = typename Base::Jacobian;
+  static constexpr int StorageDimension = GroupElement::StorageDimension;
+  // Pointer to the viewed storage, const for a `Map<const Group>`.
+  using Pointer =
+      std::conditional_t<std::is_const_v<Group>, const Scalar*, Scalar*>;
+
+  // View the element stored at `data`.
+  explicit Map(Pointer data);
+
+  // Copying a `Map` creates another view of the same memory.
+  Map(const Map& rhs) = default;
+
+  // Assignment writes through to the viewed memory (only for a mutable map).
+  Map& operator=(const GroupElement& rhs);
+  Map& operator=(const Map& rhs);
+
+  // Return a copy of the viewed element. All group operations go through
+  // this copy.
+  GroupElement value() const;
+  operator GroupElement() const;
+
+  // Return the viewed memory.
+  Pointer data() const;
+
+  // --------------------------------------------------------------------------
+  // Implement `GroupElement<>` interface.
+  static GroupElement IdentityImpl();
+  GroupElement InverseImpl() const;
+  GroupElement ComposeImpl(const GroupElement& rhs) const;
+
+  // Implement `ManifoldElement<>` interface.
+  static GroupElement FromPointImpl(const EmbeddingPoint& point);
+  static EmbeddingPoint ProjectImpl(const EmbeddingPoint& point);
+  static bool IsValidImpl(const EmbeddingPoint& point, Scalar tolerance);
+  EmbeddingPoint PointImpl() const;
+
+  // Implement `LieGroupElement<>` interface.
+  TangentVector LogImpl() const;
+  static GroupElement ExpImpl(const TangentVector& coordinate);
+  Jacobian AdjointImpl() const;
+  static std::vector<GroupElement> ExpBatchImpl(
+      const TangentBatch& coordinates);
+
+ private:
+  Pointer data_;
+};
+
+template <typename Group>
+Map<Group>::Map(Pointer data) : data_(data) {
+  assert(data_ != nullptr);
+}
+
+template <typename Group>
+Map<Group>& Map<Group>::operator=(const GroupElement& rhs) {
+  static_assert(!std::is_const_v<Group>, "Cannot assign to a Map<const T>");
+  rhs.ToStorage(data_);
+  return *this;
+}
+
+template <typename Group>
+Map<Group>& Map<Group>::operator=(const Map& rhs) {
+  return *this = rhs.value();
+}
+
+template <typename Group>
+typename Map<Group>::GroupElement Map<Group>::value() const {
+  return GroupElement::FromStorage(data_);
+}
+
+template <typename Group>
+Map<Group>::operator GroupElement() const {
+  return value();
+}
+
+template <typename Group>
+typename Map<Group>::Pointer Map<Group>::data() const {
+  return data_;
+}
+
+template <typename Group>
+/*static*/ typename Map<Group>::GroupElement Map<Group>::IdentityImpl() {
+  return GroupElement::Identity();
+}
+
+template <typename Group>
+typename Map<Group>::GroupElement Map<Group>::InverseImpl() const {
+  return value().Inverse();
+}
+
+template <typename Group>
+typename Map<Group>::GroupElement Map<Group>::ComposeImpl(
+    const GroupElement& rhs) const {
+  return value().Compose(rhs);
+}
+
+template <typename Group>
+/*static*/ typename Map<Group>::GroupElement Map<Group>::FromPointImpl(
+    const EmbeddingPoint& point) {
+  return GroupElement::FromPoint(point);
+}
+
+template <typename Group>
+/*static*/ typename Map<Group>::EmbeddingPoint Map<Group>::ProjectImpl(
+    const EmbeddingPoint& point) {
+  return GroupElement::Project(point);
+}
+
+template <typename Group>
+/*static*/ bool Map<Group>::IsValidImpl(const EmbeddingPoint& point,
+                                        Scalar tolerance) {
+  return GroupElement::IsValid(point, tolerance);
+}
+
+template <typename Group>
+typename Map<Group>::EmbeddingPoint Map<Group>::PointImpl() const {
+  return value().Point();
+}
+
+template <typename Group>
+typename Map<Group>::TangentVector Map<Group>::LogImpl() const {
+  return value().Log();
+}
+
+template <typename Group>
+/*static*/ typename Map<Group>::GroupElement Map<Group>::ExpImpl(
+    const TangentVector& coordinate) {
+  return GroupElement::Exp(coordinate);
+}
+
+template <typename Group>
+typename Map<Group>::Jacobian Map<Group>::AdjointImpl() const {
+  return value().Adjoint();
+}
+
+template <typename Group>
+/*static*/ std::vector<typename Map<Group>::GroupElement>
+Map<Group>::ExpBatchImpl(const TangentBatch& coordinates) {
+  return GroupElement::ExpBatch(coordinates);
+}
+
+}  // namespace mana
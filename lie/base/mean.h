@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "utils/parallel.h"
+
+namespace mana {
+
+// Options for `Mean()`.
+struct MeanOptions {
+  // Maximum number of tangent space (Gauss-Newton) iterations.
+  int max_iterations = 50;
+  // Stop iterating once the norm of the update falls below this value.
+  double convergence_tolerance = 1e-12;
+};
+
+// Whether `Group` provides a closed-form extrinsic mean,
+//   static Group ExtrinsicMean(const std::vector<Group>& elements,
+//                              const std::vector<Scalar>& weights);
+// which `Mean()` uses as its initial estimate.
+template <typename Group, typename = void>
+struct HasExtrinsicMean : std::false_type {};
+
+template <typename Group>
+struct HasExtrinsicMean<
+    Group, std::void_t<decltype(Group::ExtrinsicMean(
+               std::declval<const std::vector<Group>&>(),
+               std::declval<const std::vector<typename Group::Scalar>&>()))>>
+    : std::true_type {};
+
+// Compute the weighted Karcher (Frechet) mean of `elements`, the minimizer of
+//   sum_i w_i || Log(X^{-1} X_i) ||^2,
+// by iterating X <- X.Rplus(sum_i w_i X.Rminus(X_i) / sum_i w_i) until the
+// update is below `options.convergence_tolerance`. Each iteration's weighted
+// tangent sum is a deterministic parallel reduction under `policy` (see
+// utils/parallel.h). Empty `weights` weigh all elements equally; otherwise
+// weights must be non-negative, with a positive sum.
+//
+// Iteration starts from the group's closed-form extrinsic mean if it provides
+// one (see `HasExtrinsicMean`), e.g. the circular mean on SO2, and from the
+// first element otherwise. With `options.max_iterations = 0`, the extrinsic
+// mean itself is returned.
+template <typename Group, typename Policy = SequentialExecution>
+Group Mean(const std::vector<Group>& elements,
+           const std::vector<typename Group::Scalar>& weights = {},
+           const MeanOptions& options = {}, const Policy& policy = Policy());
+
+template <typename Group, typename Policy>
+Group Mean(const std::vector<Group>& elements,
+           const std::vector<typename Group::Scalar>& weights,
+           const MeanOptions& options, const Policy& policy) {
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  assert(!elements.empty());
+  assert(weights.empty() || weights.size() == elements.size());
+
+  const auto weight = [&](size_t i) -> Scalar {
+    return weights.empty() ? Scalar(1) : weights[i];
+  };
+  Scalar total_weight = 0;
+  for (size_t i = 0; i < elements.size(); ++i) {
+    assert(weight(i) >= 0);
+    total_weight += weight(i);
+  }
+  assert(total_weight > 0);
+
+  Group mean = elements.front();
+  if constexpr (HasExtrinsicMean<Group>::value) {
+    mean = Group::ExtrinsicMean(elements, weights);
+  }
+  for (int iteration = 0; iteration < options.max_iterations; ++iteration) {
+    const TangentVector sum = ParallelReduce(
+        policy, elements.size(), TangentVector(TangentVector::Zero()),
+        [&](size_t begin, size_t end) {
+          TangentVector partial = TangentVector::Zero();
+          for (size_t i = begin; i < end; ++i) {
+            partial += weight(i) * mean.Rminus(elements[i]);
+          }
+          return partial;
+        },
+        [](const TangentVector& lhs, const TangentVector& rhs) {
+          return TangentVector(lhs + rhs);
+        });
+    const TangentVector update = sum / total_weight;
+    mean = mean.Rplus(update);
+    if (update.norm() < options.convergence_tolerance) break;
+  }
+  return mean;
+}
+
+}  // namespace mana
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace mana {
+
+// Normalization policies for groups stored redundantly on a constraint surface,
+// such as SO2 as a unit complex number (or SO3 as a unit quaternion). Rounding
+// error lets the stored values drift off the surface as elements are composed,
+// and normalizing projects them back, at the cost of a square root and a
+// division. The policies decide, given a bound on the accumulated drift, when
+// a `CompositionAccumulator` (below) normalizes its running product.
+//
+// A policy implements:
+// - template <typename Scalar> bool ShouldNormalize(Scalar drift_bound);
+// which is called once per composition.
+
+// Normalize after every composition.
+struct AlwaysNormalize {
+  template <typename Scalar>
+  bool ShouldNormalize(Scalar /*drift_bound*/) {
+    return true;
+  }
+};
+
+// Normalize after every `K`-th composition.
+template <size_t K>
+struct NormalizeEvery {
+  static_assert(K > 0);
+
+  template <typename Scalar>
+  bool ShouldNormalize(Scalar /*drift_bound*/) {
+    if (++count < K) return false;
+    count = 0;
+    return true;
+  }
+
+  // Compositions since the last normalization.
+  size_t count = 0;
+};
+
+// Normalize once the tracked drift bound exceeds `tolerance`.
+struct NormalizeOnDrift {
+  template <typename Scalar>
+  bool ShouldNormalize(Scalar drift_bound) {
+    return drift_bound > tolerance;
+  }
+
+  // The largest tolerated deviation of the stored values' norm from one.
+  double tolerance = 1e-12;
+};
+
+// Accumulates a product of group elements, X = X0 * X1 * ... * Xn, as in
+// odometry integration, normalizing the running product according to the
+// `Normalization` policy. The group must provide:
+// - Group ComposeUnnormalized(const Group& rhs) const;
+// - Group Normalized() const;
+template <typename Group, typename Normalization = AlwaysNormalize>
+class CompositionAccumulator {
+ public:
+  using Scalar = typename Group::Scalar;
+
+  // A bound on the drift that a single composition with a normalized element
+  // adds to the norm of the stored values.
+  static constexpr Scalar kDriftPerComposition =
+      8 * std::numeric_limits<Scalar>::epsilon();
+  // A bound on the drift of a freshly normalized element.
+  static constexpr Scalar kDriftAfterNormalization =
+      2 * std::numeric_limits<Scalar>::epsilon();
+
+  // Construct with an initial (normalized) value.
+  explicit CompositionAccumulator(Group initial = Group::Identity(),
+                                  Normalization normalization = {});
+
+  // Right-compose the running product with `rhs`, which is assumed to be
+  // normalized.
+  void Compose(const Group& rhs);
+
+  // Normalize the running product now.
+  void Normalize();
+
+  // Return the running product. Its drift from the constraint surface is at
+  // most `DriftBound()`.
+  const Group& value() const;
+
+  // Return the bound on the running product's drift.
+  Scalar DriftBound() const;
+
+  // Return the number of normalizations performed so far.
+  size_t NumNormalizations() const;
+
+ private:
+  Group value_;
+  Normalization normalization_;
+  Scalar drift_bound_ = kDriftAfterNormalization;
+  size_t num_normalizations_ = 0;
+};
+
+template <typename Group, typename Normalization>
+CompositionAccumulator<Group, Normalization>::CompositionAccumulator(
+    Group initial, Normalization normalization)
+    : value_(std::move(initial)), normalization_(std::move(normalization)) {}
+
+template <typename Group, typename Normalization>
+void CompositionAccumulator<Group, Normalization>::Compose(const Group& rhs) {
+  value_ = value_.ComposeUnnormalized(rhs);
+  drift_bound_ += kDriftPerComposition;
+  if (normalization_.ShouldNormalize(drift_bound_)) Normalize();
+}
+
+template <typename Group, typename Normalization>
+void CompositionAccumulator<Group, Normalization>::Normalize() {
+  value_ = value_.Normalized();
+  drift_bound_ = kDriftAfterNormalization;
+  ++num_normalizations_;
+}
+
+template <typename Group, typename Normalization>
+const Group& CompositionAccumulator<Group, Normalization>::value() const {
+  return value_;
+}
+
+template <typename Group, typename Normalization>
+typename CompositionAccumulator<Group, Normalization>::Scalar
+CompositionAccumulator<Group, Normalization>::DriftBound() const {
+  return drift_bound_;
+}
+
+template <typename Group, typename Normalization>
+size_t CompositionAccumulator<Group, Normalization>::NumNormalizations() const {
+  return num_normalizations_;
+}
+
+}  // namespace mana
@@ -0,0 +1,68 @@
+#pragma once
+
+namespace mana {
+
+// Retraction policies for `LieGroupElement<>::Plus` and `Minus`. A retraction
+// R maps tangent vectors at the identity to group elements, with R(0) = I and
+// dR(0) = I, so that X.Plus(v) = X * R(v) agrees with X.Rplus(v) to first
+// order. Its local inverse L maps group elements near the identity back to
+// tangent vectors, and X.Minus(Y) = L(X^{-1} * Y).
+//
+// Away from convergence, an optimizer only needs its steps to be first-order
+// correct, so it may use a cheap retraction in its inner loops and switch to
+// the exact one once the steps become small:
+//
+//   x = x.Plus<CayleyRetraction>(step);  // Early iterations.
+//   x = x.Plus(step);                    // Near convergence.
+//
+// Each policy forwards to a hook on the group. `LieGroupElement<>` provides
+// generic implementations of the hooks in terms of the group's matrix
+// representation, which groups may replace with cheaper closed forms.
+
+// The exact exponential map, R(v) = Exp(v) and L(X) = Log(X). This is the
+// default.
+struct ExpRetraction {
+  template <typename Group>
+  static Group Retract(const typename Group::TangentVector& coordinate) {
+    return Group::Exp(coordinate);
+  }
+
+  template <typename Group>
+  static typename Group::TangentVector Local(const Group& element) {
+    return element.Log();
+  }
+};
+
+// The Cayley transform, R(v) = (I - A / 2)^{-1} (I + A / 2) where A = hat(v),
+// and its exact inverse L(X) = vee(2 (X + I)^{-1} (X - I)). Agrees with Exp to
+// second order, and maps onto the group exactly (no projection is needed) for
+// quadratic groups such as SO(n). L is undefined for rotations by pi.
+struct CayleyRetraction {
+  template <typename Group>
+  static Group Retract(const typename Group::TangentVector& coordinate) {
+    return Group::CayleyImpl(coordinate);
+  }
+
+  template <typename Group>
+  static typename Group::TangentVector Local(const Group& element) {
+    return element.InverseCayleyImpl();
+  }
+};
+
+// The first-order approximation of Exp followed by a projection back onto the
+// group, R(v) = Project(I + A) where A = hat(v), with its exact inverse. For
+// the polar projection of SO(n), L(X) = vee((X + X^T)^{-1} (X - X^T)). Groups
+// with another projection must provide their own L.
+struct FirstOrderRetraction {
+  template <typename Group>
+  static Group Retract(const typename Group::TangentVector& coordinate) {
+    return Group::FirstOrderRetractImpl(coordinate);
+  }
+
+  template <typename Group>
+  static typename Group::TangentVector Local(const Group& element) {
+    return element.FirstOrderLocalImpl();
+  }
+};
+
+}  // namespace mana
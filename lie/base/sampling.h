@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "lie/base/manifold_array.h"
+#include "utils/parallel.h"
+#include "utils/philox.h"
+
+namespace mana {
+
+// Batched random sampling on Lie groups, e.g. for particle filters. All random
+// numbers come from a counter-based generator (see utils/philox.h): the noise
+// drawn for element i is a pure function of (seed, stream, i), so sampling is
+// parallelized over elements and is reproducible regardless of the execution
+// policy or thread count. Use a distinct `stream` (e.g. the filter's step
+// count) for each batch drawn with the same seed.
+
+// Return the standard normal tangent vector for element `index` of `stream`.
+// Its Philox counter is {index (low and high words), block, stream}, where
+// each block provides two coordinates.
+template <typename Group>
+typename Group::TangentVector StandardGaussianTangent(const Philox4x32& philox,
+                                                      uint64_t index,
+                                                      uint32_t stream);
+
+// Draw `n` tangent vectors from N(0, L L'), stored column-wise, where `L` is a
+// square root (e.g. the Cholesky factor) of the noise covariance.
+template <typename Group, typename Policy = SequentialExecution>
+typename Group::TangentBatch SampleGaussianTangents(
+    size_t n, const typename Group::Jacobian& noise_sqrt, uint64_t seed,
+    uint32_t stream, const Policy& policy = Policy());
+
+// Perturb every element in place with tangent noise drawn from N(0, L L'):
+// X_i <- X_i.Rplus(L z_i), z_i ~ N(0, I).
+template <typename Group, typename Policy = SequentialExecution>
+void PerturbGaussian(ManifoldArray<Group>& elements,
+                     const typename Group::Jacobian& noise_sqrt, uint64_t seed,
+                     uint32_t stream, const Policy& policy = Policy());
+
+// Systematic resampling: given (unnormalized, non-negative) weights, return as
+// many indices, where index j is the element whose interval of the normalized
+// cumulative weights contains (offset + j) / N, for an offset in [0, 1). Runs
+// in linear time, and has lower variance than multinomial resampling. Gather
+// the resampled elements with `Gather()` (see manifold_array.h).
+template <typename Scalar>
+std::vector<size_t> SystematicResample(const std::vector<Scalar>& weights,
+                                       Scalar offset);
+
+// As above, writing the indices to `indices` (resized to weights.size()), so
+// repeated calls reuse its allocation.
+template <typename Scalar>
+void SystematicResample(const std::vector<Scalar>& weights, Scalar offset,
+                        std::vector<size_t>& indices);
+
+template <typename Group>
+typename Group::TangentVector StandardGaussianTangent(const Philox4x32& philox,
+                                                      uint64_t index,
+                                                      uint32_t stream) {
+  using Scalar = typename Group::Scalar;
+  typename Group::TangentVector tangent;
+  for (int block = 0; 2 * block < Group::Dimension; ++block) {
+    const std::array<double, 2> pair = ToGaussianPair(
+        philox({static_cast<uint32_t>(index),
+                static_cast<uint32_t>(index >> 32),
+                static_cast<uint32_t>(block), stream}));
+    tangent(2 * block) = static_cast<Scalar>(pair[0]);
+    if (2 * block + 1 < Group::Dimension) {
+      tangent(2 * block + 1) = static_cast<Scalar>(pair[1]);
+    }
+  }
+  return tangent;
+}
+
+template <typename Group, typename Policy>
+typename Group::TangentBatch SampleGaussianTangents(
+    size_t n, const typename Group::Jacobian& noise_sqrt, uint64_t seed,
+    uint32_t stream, const Policy& policy) {
+  const Philox4x32 philox(seed);
+  typename Group::TangentBatch tangents(Group::Dimension, n);
+  ParallelFor(policy, n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      tangents.col(i).noalias() =
+          noise_sqrt * StandardGaussianTangent<Group>(philox, i, stream);
+    }
+  });
+  return tangents;
+}
+
+template <typename Group, typename Policy>
+void PerturbGaussian(ManifoldArray<Group>& elements,
+                     const typename Group::Jacobian& noise_sqrt, uint64_t seed,
+                     uint32_t stream, const Policy& policy) {
+  const Philox4x32 philox(seed);
+  ParallelFor(policy, elements.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const typename Group::TangentVector noise =
+          noise_sqrt * StandardGaussianTangent<Group>(philox, i, stream);
+      elements.Set(i, elements[i].Rplus(noise));
+    }
+  });
+}
+
+template <typename Scalar>
+std::vector<size_t> SystematicResample(const std::vector<Scalar>& weights,
+                                       Scalar offset) {
+  std::vector<size_t> indices;
+  SystematicResample(weights, offset, indices);
+  return indices;
+}
+
+template <typename Scalar>
+void SystematicResample(const std::vector<Scalar>& weights, Scalar offset,
+                        std::vector<size_t>& indices) {
+  assert(offset >= 0 && offset < 1);
+  const size_t n = weights.size();
+  Scalar total_weight = 0;
+  for (const Scalar weight : weights) {
+    assert(weight >= 0);
+    total_weight += weight;
+  }
+  assert(n == 0 || total_weight > 0);
+
+  indices.resize(n);
+  size_t index = 0;
+  Scalar cumulative_weight = n > 0 ? weights[0] : 0;
+  for (size_t j = 0; j < n; ++j) {
+    const Scalar position = (offset + j) / n * total_weight;
+    // Guard the upper end against rounding in the cumulative sum.
+    while (cumulative_weight <= position && index + 1 < n) {
+      cumulative_weight += weights[++index];
+    }
+    indices[j] = index;
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+
+namespace mana {
+
+// The metric that spatial indices over manifold elements (see
+// vantage_point_tree.h) search with, evaluated from a query element to a
+// contiguous range of elements in structure-of-arrays storage (as laid out by
+// `ManifoldArray<T>`).
+//
+// The default is `DistanceTo()` itself, one element at a time. A
+// specialization may substitute any metric that is a strictly increasing
+// function of `DistanceTo()`, e.g. the chordal distance in the embedding,
+// which vectorizes where the geodesic distance needs trigonometry. Indices
+// then search in that metric, converting radii with `FromDistance()`, and
+// report exact `DistanceTo()` values for their results.
+template <typename T>
+struct SearchMetric {
+  using Scalar = typename T::Scalar;
+  using Storage = Eigen::Matrix<Scalar, T::StorageDimension, Eigen::Dynamic,
+                                Eigen::RowMajor>;
+
+  // Set distances[i - begin] to the distance from `query` to the element in
+  // column i of `storage`, for i in [begin, end).
+  static void Distances(const T& query, const Storage& storage, size_t begin,
+                        size_t end, Scalar* distances);
+
+  // Map a `DistanceTo()` value to the search metric.
+  static Scalar FromDistance(Scalar distance);
+};
+
+template <typename T>
+/*static*/ void SearchMetric<T>::Distances(const T& query,
+                                           const Storage& storage,
+                                           size_t begin, size_t end,
+                                           Scalar* distances) {
+  Scalar coordinates[T::StorageDimension];
+  for (size_t i = begin; i < end; ++i) {
+    for (int k = 0; k < T::StorageDimension; ++k) {
+      coordinates[k] = storage(k, i);
+    }
+    distances[i - begin] = query.DistanceTo(T::FromStorage(coordinates));
+  }
+}
+
+template <typename T>
+/*static*/ typename SearchMetric<T>::Scalar SearchMetric<T>::FromDistance(
+    Scalar distance) {
+  return distance;
+}
+
+}  // namespace mana
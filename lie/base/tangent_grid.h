@@ -0,0 +1,172 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace mana {
+
+// A uniform grid over the tangent chart at the identity of a Lie group,
+// X = Exp(tau), which quantizes elements into integer cells
+//   cell_k = floor(tau_k / resolution_k)
+// for hashing, e.g. to deduplicate poses or find near-duplicate candidates in
+// O(1) (see `GroupHashMap` in group_hash_map.h). Each tangent coordinate has
+// its own resolution, e.g. rotation bins in radians and translation bins in
+// meters for a pose.
+//
+// Charts of compact groups wrap around (e.g. rotation angles at +-pi), so the
+// cells at the boundary of the chart are partial. Each such cell is merged
+// with the cell it wraps around to, and for the merged cells to be full, the
+// resolution of a periodic coordinate should divide its period (e.g. 2 pi / n
+// for angles).
+//
+// Elements within a tolerance of each other may fall either side of a cell
+// boundary; `ForEachCell()` enumerates the cells a query's near neighbors may
+// lie in. Neighboring cells are found by perturbing the query along the group
+// (X.Rplus(delta)) rather than by offsetting cell indices, so that they wrap
+// with the chart. For abelian groups, whose chart is flat, this finds every
+// element within the tolerance; for others, the chart distorts distances away
+// from the identity, and the tolerance should be scaled to cover the
+// distortion.
+template <typename Group>
+class TangentGrid {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  static constexpr int Dimension = Group::Dimension;
+  using Cell = Eigen::Matrix<int64_t, Dimension, 1>;
+
+  // Construct a grid of the given (positive) cell size along each coordinate.
+  explicit TangentGrid(const TangentVector& resolution);
+
+  // Return the cell containing `element`.
+  Cell Quantize(const Group& element) const;
+
+  // Call fn(cell) for the cell of `element`, and for each neighboring cell
+  // that may hold an element within `tolerance` of it. `tolerance` must be at
+  // most half of every resolution, so that only the nearer boundary along
+  // each coordinate matters. Cells may be visited more than once.
+  template <typename Fn>
+  void ForEachCell(const Group& element, Scalar tolerance, Fn&& fn) const;
+
+  // Hash a cell, mixing all of its coordinates.
+  static uint64_t Hash(const Cell& cell);
+
+  const TangentVector& resolution() const;
+
+ private:
+  // Return the (merged) cell containing Exp(coordinate), and the cell
+  // containing `coordinate` in the chart.
+  Cell Quantize(const TangentVector& coordinate) const;
+  Cell Floor(const TangentVector& coordinate) const;
+
+  TangentVector resolution_;
+  TangentVector inverse_resolution_;
+};
+
+template <typename Group>
+TangentGrid<Group>::TangentGrid(const TangentVector& resolution)
+    : resolution_(resolution), inverse_resolution_(resolution.cwiseInverse()) {
+  assert((resolution.array() > 0).all());
+}
+
+template <typename Group>
+typename TangentGrid<Group>::Cell TangentGrid<Group>::Quantize(
+    const Group& element) const {
+  return Quantize(element.Log());
+}
+
+template <typename Group>
+typename TangentGrid<Group>::Cell TangentGrid<Group>::Quantize(
+    const TangentVector& coordinate) const {
+  // Merge a cell straddling the boundary of the chart with the cell it wraps
+  // to, identifying both by the least (lexicographically) cell that the
+  // points a quarter and three quarters across it fall in. (Its center may
+  // lie exactly on the boundary.)
+  Cell merged = Floor(coordinate);
+  const Cell cell = merged;
+  for (const Scalar fraction : {Scalar(0.25), Scalar(0.75)}) {
+    const TangentVector point =
+        (cell.template cast<Scalar>().array() + fraction) * resolution_.array();
+    const Cell wrapped = Floor(Group::Exp(point).Log());
+    for (int k = 0; k < Dimension; ++k) {
+      if (wrapped(k) != merged(k)) {
+        if (wrapped(k) < merged(k)) merged = wrapped;
+        break;
+      }
+    }
+  }
+  return merged;
+}
+
+template <typename Group>
+typename TangentGrid<Group>::Cell TangentGrid<Group>::Floor(
+    const TangentVector& coordinate) const {
+  Cell cell;
+  for (int k = 0; k < Dimension; ++k) {
+    cell(k) = static_cast<int64_t>(
+        std::floor(coordinate(k) * inverse_resolution_(k)));
+  }
+  return cell;
+}
+
+template <typename Group>
+template <typename Fn>
+void TangentGrid<Group>::ForEachCell(const Group& element, Scalar tolerance,
+                                     Fn&& fn) const {
+  assert((2 * tolerance <= resolution_.array()).all());
+  const TangentVector coordinate = element.Log();
+  fn(Quantize(coordinate));
+
+  // Find the coordinates within `tolerance` of a cell boundary, and the
+  // half-cell step across the nearer one, which lands inside the neighbor.
+  const Cell cell = Floor(coordinate);
+  TangentVector steps = TangentVector::Zero();
+  int near[Dimension];
+  int num_near = 0;
+  for (int k = 0; k < Dimension; ++k) {
+    const Scalar offset =
+        (coordinate(k) * inverse_resolution_(k) - cell(k)) * resolution_(k);
+    if (offset < tolerance) {
+      steps(k) = -resolution_(k) / 2;
+    } else if (resolution_(k) - offset < tolerance) {
+      steps(k) = resolution_(k) / 2;
+    } else {
+      continue;
+    }
+    near[num_near++] = k;
+  }
+
+  // Visit the neighbors across every nonempty subset of those boundaries.
+  for (uint32_t subset = 1; subset < (1u << num_near); ++subset) {
+    TangentVector step = TangentVector::Zero();
+    for (int j = 0; j < num_near; ++j) {
+      if (subset & (1u << j)) step(near[j]) = steps(near[j]);
+    }
+    fn(Quantize(element.Rplus(step)));
+  }
+}
+
+template <typename Group>
+/*static*/ uint64_t TangentGrid<Group>::Hash(const Cell& cell) {
+  // Combine the coordinates with the splitmix64 finalizer.
+  uint64_t hash = 0x9e3779b97f4a7c15ull;
+  for (int k = 0; k < Dimension; ++k) {
+    hash ^= static_cast<uint64_t>(cell(k)) + 0x9e3779b97f4a7c15ull +
+            (hash << 6) + (hash >> 2);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+  }
+  return hash;
+}
+
+template <typename Group>
+const typename TangentGrid<Group>::TangentVector&
+TangentGrid<Group>::resolution() const {
+  return resolution_;
+}
+
+}  // namespace mana
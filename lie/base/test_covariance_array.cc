@@ -0,0 +1,141 @@
+#include <Eigen/Dense>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/covariance_array.h"
+#include "lie/base/manifold_array.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+using CovarianceArray3d = CovarianceArray<double, 3>;
+
+Eigen::Matrix3d RandomCovariance() {
+  const Eigen::Matrix3d square_root = Eigen::Matrix3d::Random();
+  return square_root * square_root.transpose();
+}
+
+// A non-abelian test double: the invertible 3x3 matrices, each acting as its
+// own adjoint, with just the interface that covariance propagation uses.
+struct MatrixGroup {
+  using Scalar = double;
+  using Jacobian = Eigen::Matrix3d;
+  static constexpr int Dimension = 3;
+  static constexpr int StorageDimension = 9;
+  static constexpr bool IsAbelian = false;
+
+  static MatrixGroup FromStorage(const Scalar* storage) {
+    return MatrixGroup{Eigen::Matrix3d::Map(storage)};
+  }
+  void ToStorage(Scalar* storage) const {
+    Eigen::Matrix3d::Map(storage) = matrix;
+  }
+  MatrixGroup Inverse() const { return MatrixGroup{matrix.inverse()}; }
+  Jacobian Adjoint() const { return matrix; }
+
+  Eigen::Matrix3d matrix = Eigen::Matrix3d::Identity();
+};
+
+MatrixGroup RandomMatrixGroup() {
+  return MatrixGroup{Eigen::Matrix3d::Identity() +
+                     0.5 * Eigen::Matrix3d::Random()};
+}
+
+TEST(CovarianceArray, Packing) {
+  static_assert(CovarianceArray3d::PackedDimension == 6);
+  static_assert(CovarianceArray3d::PackedIndex(0, 0) == 0);
+  static_assert(CovarianceArray3d::PackedIndex(0, 2) == 2);
+  static_assert(CovarianceArray3d::PackedIndex(1, 1) == 3);
+  static_assert(CovarianceArray3d::PackedIndex(2, 1) == 4);
+  static_assert(CovarianceArray3d::PackedIndex(2, 2) == 5);
+
+  const Eigen::Matrix3d value = RandomCovariance();
+  CovarianceArray3d covariances(4, value);
+  ASSERT_EQ(covariances.size(), 4);
+  EXPECT_EQ(covariances.storage().rows(), 6);
+  for (size_t i = 0; i < covariances.size(); ++i) {
+    EXPECT_EQ(covariances[i], value);
+  }
+
+  const Eigen::Matrix3d other = RandomCovariance();
+  covariances.Set(2, other);
+  EXPECT_EQ(covariances[2], other);
+  EXPECT_EQ(covariances.storage()(CovarianceArray3d::PackedIndex(1, 2), 2),
+            other(2, 1));
+}
+
+TEST(CovarianceArray, PropagateCovariance) {
+  constexpr size_t kSize = 100;
+  std::vector<Eigen::Matrix3d> expected;
+  std::vector<Eigen::Matrix3d> jacobians;
+  CovarianceArray3d covariances(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    covariances.Set(i, RandomCovariance());
+    jacobians.push_back(Eigen::Matrix3d::Random());
+    expected.push_back(jacobians[i] * covariances[i] *
+                       jacobians[i].transpose());
+  }
+  PropagateCovariance(ParallelExecution{/*num_threads=*/4, /*grain_size=*/8},
+                      covariances, [&](size_t i) { return jacobians[i]; });
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(covariances[i].isApprox(expected[i], 1e-12));
+  }
+}
+
+TEST(CovarianceArray, PropagateAbelian) {
+  using Matrix1d = SO2GroupElement::Jacobian;
+  const ManifoldArray<SO2GroupElement> elements(
+      std::vector<SO2GroupElement>{SO2GroupElement(0.3), SO2GroupElement(-2.0),
+                                   SO2GroupElement(1.0)});
+  GroupCovarianceArray<SO2GroupElement> lhs(3, Matrix1d(0.01));
+  const GroupCovarianceArray<SO2GroupElement> rhs(3, Matrix1d(0.02));
+  lhs.Set(1, Matrix1d(0.05));
+
+  // The adjoint of SO2 is the identity: inversion preserves covariance, and
+  // composition adds covariances.
+  PropagateInverse(SequentialExecution(), elements, lhs);
+  EXPECT_EQ(lhs[1](0, 0), 0.05);
+  PropagateCompose(SequentialExecution(), lhs, elements, rhs, lhs);
+  EXPECT_NEAR(lhs[0](0, 0), 0.03, 1e-15);
+  EXPECT_NEAR(lhs[1](0, 0), 0.07, 1e-15);
+  EXPECT_NEAR(lhs[2](0, 0), 0.03, 1e-15);
+}
+
+TEST(CovarianceArray, PropagateNonAbelian) {
+  constexpr size_t kSize = 50;
+  const ParallelExecution policy{/*num_threads=*/4, /*grain_size=*/8};
+  std::vector<MatrixGroup> elements;
+  CovarianceArray3d lhs(kSize);
+  CovarianceArray3d rhs(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    elements.push_back(RandomMatrixGroup());
+    lhs.Set(i, RandomCovariance());
+    rhs.Set(i, RandomCovariance());
+  }
+  const ManifoldArray<MatrixGroup> array(elements);
+
+  // Inversion: Ad(X) P Ad(X)^T.
+  CovarianceArray3d inverted = lhs;
+  PropagateInverse(policy, array, inverted);
+  for (size_t i = 0; i < kSize; ++i) {
+    const Eigen::Matrix3d adjoint = elements[i].matrix;
+    EXPECT_TRUE(inverted[i].isApprox(
+        adjoint * lhs[i] * adjoint.transpose(), 1e-12));
+  }
+
+  // Composition: Ad(Y^{-1}) P_x Ad(Y^{-1})^T + P_y, also in place.
+  CovarianceArray3d composed(kSize);
+  PropagateCompose(policy, lhs, array, rhs, composed);
+  CovarianceArray3d in_place = rhs;
+  PropagateCompose(policy, lhs, array, in_place, in_place);
+  for (size_t i = 0; i < kSize; ++i) {
+    const Eigen::Matrix3d adjoint = elements[i].matrix.inverse();
+    const Eigen::Matrix3d expected =
+        adjoint * lhs[i] * adjoint.transpose() + rhs[i];
+    EXPECT_TRUE(composed[i].isApprox(expected, 1e-12));
+    EXPECT_TRUE(in_place[i].isApprox(expected, 1e-12));
+  }
+}
+
+}  // namespace mana
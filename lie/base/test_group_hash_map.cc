@@ -0,0 +1,45 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/group_hash_map.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+TEST(GroupHashMap, Deduplicates) {
+  const double tolerance = 1e-3;
+  GroupHashMap<SO2GroupElement, int> map(Vector1d(2 * M_PI / 1000), tolerance);
+  EXPECT_TRUE(map.Insert(SO2GroupElement(0.5), 0).second);
+  EXPECT_TRUE(map.Insert(SO2GroupElement(M_PI - 1e-4), 1).second);
+
+  // Near-duplicates, including across +-pi, are found rather than inserted.
+  const auto [value, inserted] = map.Insert(SO2GroupElement(0.5 + 5e-4), 2);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*value, 0);
+  ASSERT_NE(map.Find(SO2GroupElement(-M_PI + 5e-4)), nullptr);
+  EXPECT_EQ(*map.Find(SO2GroupElement(-M_PI + 5e-4)), 1);
+  EXPECT_EQ(map.Find(SO2GroupElement(0.5 + 2e-3)), nullptr);
+  EXPECT_EQ(map.size(), 2);
+
+  // Deduplicate random headings, against brute force.
+  std::srand(0);
+  map.clear();
+  std::vector<SO2GroupElement> distinct;
+  for (int i = 0; i < 2000; ++i) {
+    const SO2GroupElement element(M_PI * Eigen::Vector2d::Random()(0));
+    bool duplicate = false;
+    for (const SO2GroupElement& other : distinct) {
+      duplicate |= element.DistanceTo(other) <= tolerance;
+    }
+    if (!duplicate) distinct.push_back(element);
+    EXPECT_EQ(map.Insert(element, i).second, !duplicate);
+  }
+  EXPECT_EQ(map.size(), distinct.size());
+}
+
+}  // namespace mana
@@ -0,0 +1,132 @@
+#include <cmath>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "lie/base/lie_algebra_element.h"
+
+namespace mana {
+
+// This test implements so(3), the Lie algebra of 3D rotations, whose elements
+// are skew-symmetric 3x3 matrices. Only the algebra is needed, so its group is
+// left undefined.
+class so3;
+class SO3;
+
+template <>
+struct AlgebraTraits<so3> {
+  using Element = so3;
+  using Scalar = double;
+  using Vector = Eigen::Vector<Scalar, 3>;
+  static constexpr int Dimension = 3;
+};
+
+template <>
+struct LieAlgebraTraits<so3> {
+  using AlgebraElement = so3;
+  using GroupElement = SO3;
+  using Matrix = Eigen::Matrix<double, 3, 3>;
+};
+
+class so3 : public LieAlgebraElement<so3> {
+ public:
+  using Vector = typename AlgebraTraits<so3>::Vector;
+  using Matrix = typename LieAlgebraTraits<so3>::Matrix;
+
+  // Convenience: construct from 3 scalars.
+  so3(Scalar x, Scalar y, Scalar z) : so3(Vector(x, y, z)) {}
+
+  // Implement `AlgebraElement` interface.
+  explicit so3(Vector coordinates)
+      : LieAlgebraElement<so3>(std::move(coordinates)) {}
+
+  // Implement `LieAlgebraElement` interface.
+  explicit so3(const Matrix& matrix)
+      : so3(matrix(2, 1), matrix(0, 2), matrix(1, 0)) {}
+
+  Matrix AsMatrixImpl() const {
+    Matrix matrix;
+    matrix << 0, -coordinates_(2), coordinates_(1),  //
+        coordinates_(2), 0, -coordinates_(0),        //
+        -coordinates_(1), coordinates_(0), 0;
+    return matrix;
+  }
+};
+
+// Rodrigues' formula, exp: so(3) -> SO(3).
+Eigen::Matrix3d Exp(const so3& algebra) {
+  const double angle = algebra.Vee().norm();
+  const Eigen::Matrix3d hat = algebra.AsMatrix();
+  return Eigen::Matrix3d::Identity() + std::sin(angle) / angle * hat +
+         (1 - std::cos(angle)) / (angle * angle) * hat * hat;
+}
+
+// The inverse of Rodrigues' formula, log: SO(3) -> so(3), for angles in
+// (0, pi).
+so3 Log(const Eigen::Matrix3d& rotation) {
+  const double angle = std::acos((rotation.trace() - 1) / 2);
+  return so3(Eigen::Matrix3d(angle / (2 * std::sin(angle)) *
+                             (rotation - rotation.transpose())));
+}
+
+TEST(LieAlgebraElement, Bracket) {
+  const so3 a(0.1, -0.4, 0.3);
+  const so3 b(0.7, 0.2, -0.5);
+  EXPECT_TRUE(a.Bracket(b).Vee().isApprox(a.Vee().cross(b.Vee())));
+}
+
+TEST(LieAlgebraElement, ad) {
+  const so3 a(0.1, -0.4, 0.3);
+  EXPECT_TRUE(a.ad().isApprox(a.AsMatrix()));
+}
+
+TEST(LieAlgebraElement, RightJacobian) {
+  // Closed form of the right Jacobian of so(3), for angle theta:
+  //   Jr = I - (1 - cos theta) / theta^2 hat + (theta - sin theta) / theta^3
+  //   hat^2.
+  const so3 a(0.8, -1.1, 0.6);
+  const double angle = a.Vee().norm();
+  const Eigen::Matrix3d hat = a.AsMatrix();
+  const Eigen::Matrix3d expected =
+      Eigen::Matrix3d::Identity() -
+      (1 - std::cos(angle)) / (angle * angle) * hat +
+      (angle - std::sin(angle)) / (angle * angle * angle) * hat * hat;
+  EXPECT_TRUE(a.RightJacobian().isApprox(expected, 1e-12));
+
+  // Exp(a + da) ~= Exp(a) Exp(Jr da).
+  const so3 da(1e-6, 2e-6, -1e-6);
+  const Eigen::Matrix3d perturbed = Exp(a + da);
+  const Eigen::Matrix3d linearized =
+      Exp(a) * Exp(so3(Eigen::Vector3d(a.RightJacobian() * da.Vee())));
+  EXPECT_TRUE(perturbed.isApprox(linearized, 1e-10));
+}
+
+TEST(LieAlgebraElement, BCH) {
+  const so3 a(0.1, -0.4, 0.3);
+  const so3 b(0.7, 0.2, -0.5);
+  EXPECT_EQ(so3::BCH<1>(a, b), a + b);
+
+  // Scaling both arguments by `s`, the error of the order-k truncation shrinks
+  // as s^(k + 1).
+  const auto error = [&](auto bch, double s) {
+    const so3 sa = a * s;
+    const so3 sb = b * s;
+    const so3 expected = Log(Exp(sa) * Exp(sb));
+    return (bch(sa, sb).Vee() - expected.Vee()).norm();
+  };
+  const auto bch2 = [](const so3& x, const so3& y) {
+    return so3::BCH<2>(x, y);
+  };
+  const auto bch3 = [](const so3& x, const so3& y) {
+    return so3::BCH<3>(x, y);
+  };
+  const auto bch4 = [](const so3& x, const so3& y) {
+    return so3::BCH<4>(x, y);
+  };
+  EXPECT_NEAR(std::log2(error(bch2, 0.02) / error(bch2, 0.01)), 3, 0.1);
+  EXPECT_NEAR(std::log2(error(bch3, 0.04) / error(bch3, 0.02)), 4, 0.1);
+  EXPECT_NEAR(std::log2(error(bch4, 0.08) / error(bch4, 0.04)), 5, 0.1);
+  EXPECT_LT(error(bch4, 1.0), error(bch3, 1.0));
+  EXPECT_LT(error(bch3, 1.0), error(bch2, 1.0));
+}
+
+}  // namespace mana
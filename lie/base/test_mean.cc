@@ -0,0 +1,59 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/mean.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+TEST(Mean, WeightedKarcherMean) {
+  static_assert(HasExtrinsicMean<SO2GroupElement>::value);
+  // Angles straddling the +/- pi wrap-around. Unwrapped, they are 3.0,
+  // 2 pi - 3.0 and 2.5, and the Karcher mean is their (weighted) average.
+  const std::vector<SO2GroupElement> elements = {
+      SO2GroupElement(3.0), SO2GroupElement(-3.0), SO2GroupElement(2.5)};
+  const double unwrapped[] = {3.0, 2 * M_PI - 3.0, 2.5};
+  EXPECT_LT(Mean(elements).DistanceTo(SO2GroupElement(
+                (unwrapped[0] + unwrapped[1] + unwrapped[2]) / 3)),
+            1e-12);
+
+  const std::vector<double> weights = {1, 2, 5};
+  const SO2GroupElement expected(
+      (unwrapped[0] + 2 * unwrapped[1] + 5 * unwrapped[2]) / 8);
+  const SO2GroupElement mean = Mean(elements, weights);
+  EXPECT_LT(mean.DistanceTo(expected), 1e-12);
+
+  // The circular mean only approximates the Karcher mean.
+  MeanOptions options;
+  options.max_iterations = 0;
+  const SO2GroupElement circular_mean = Mean(elements, weights, options);
+  EXPECT_EQ(circular_mean, SO2GroupElement::ExtrinsicMean(elements, weights));
+  EXPECT_GT(circular_mean.DistanceTo(expected), 1e-3);
+  EXPECT_LT(circular_mean.DistanceTo(expected), 1e-1);
+}
+
+TEST(Mean, Parallel) {
+  std::vector<SO2GroupElement> elements;
+  std::vector<double> weights;
+  for (size_t i = 0; i < 20000; ++i) {
+    elements.emplace_back(1.0 + std::sin(0.37 * i));
+    weights.push_back(1 + i % 7);
+  }
+  const SO2GroupElement sequential =
+      Mean(elements, weights, MeanOptions(), SequentialExecution{256});
+  const SO2GroupElement parallel =
+      Mean(elements, weights, MeanOptions(), ParallelExecution{4, 256});
+  EXPECT_EQ(parallel.Log()(0), sequential.Log()(0));
+
+  // The Karcher mean is the zero of the weighted sum of tangents.
+  double residual = 0;
+  for (size_t i = 0; i < elements.size(); ++i) {
+    residual += weights[i] * parallel.Rminus(elements[i])(0);
+  }
+  EXPECT_NEAR(residual, 0, 1e-9);
+}
+
+}  // namespace mana
@@ -0,0 +1,62 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/manifold_array.h"
+#include "lie/base/sampling.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+TEST(Sampling, PerturbGaussian) {
+  constexpr size_t kSize = 20000;
+  const SO2GroupElement origin(3.0);
+  ManifoldArray<SO2GroupElement> particles(kSize, origin);
+  const SO2GroupElement::Jacobian noise_sqrt(0.1);
+  PerturbGaussian(particles, noise_sqrt, /*seed=*/7, /*stream=*/3,
+                  ParallelExecution{/*num_threads=*/4, /*grain_size=*/512});
+
+  // Reproducible under any execution policy, and equal to Rplus of the
+  // sampled tangents.
+  ManifoldArray<SO2GroupElement> sequential(kSize, origin);
+  PerturbGaussian(sequential, noise_sqrt, 7, 3);
+  EXPECT_EQ(particles.storage(), sequential.storage());
+  const SO2GroupElement::TangentBatch tangents =
+      SampleGaussianTangents<SO2GroupElement>(kSize, noise_sqrt, 7, 3);
+  double sum = 0;
+  double sum_squares = 0;
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(particles[i], origin.Rplus(tangents.col(i)));
+    sum += tangents(0, i);
+    sum_squares += tangents(0, i) * tangents(0, i);
+  }
+  EXPECT_NEAR(sum / kSize, 0, 3e-3);
+  EXPECT_NEAR(std::sqrt(sum_squares / kSize), 0.1, 3e-3);
+
+  // A different stream gives different noise.
+  PerturbGaussian(sequential, noise_sqrt, 7, 4);
+  EXPECT_NE(particles.storage(), sequential.storage());
+}
+
+TEST(Sampling, SystematicResample) {
+  const std::vector<double> weights = {0, 1, 0, 2, 1, 0};
+  EXPECT_EQ(SystematicResample(weights, 0.0),
+            (std::vector<size_t>{1, 1, 3, 3, 3, 4}));
+  EXPECT_EQ(SystematicResample(weights, 0.99),
+            (std::vector<size_t>{1, 3, 3, 3, 4, 4}));
+
+  const ManifoldArray<SO2GroupElement> particles(
+      std::vector<SO2GroupElement>{SO2GroupElement(0.1), SO2GroupElement(0.2),
+                                   SO2GroupElement(0.3)});
+  const ManifoldArray<SO2GroupElement> resampled =
+      Gather(SequentialExecution(), particles, {2, 0, 0, 1});
+  ASSERT_EQ(resampled.size(), 4);
+  EXPECT_EQ(resampled[0], particles[2]);
+  EXPECT_EQ(resampled[1], particles[0]);
+  EXPECT_EQ(resampled[2], particles[0]);
+  EXPECT_EQ(resampled[3], particles[1]);
+}
+
+}  // namespace mana
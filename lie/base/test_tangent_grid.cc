@@ -0,0 +1,42 @@
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "lie/base/tangent_grid.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+// The generic grid, instantiated on SO2, whose chart wraps around at +-pi.
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+TEST(TangentGrid, WrapsAroundChart) {
+  // Odd and even numbers of cells around the circle.
+  for (const int num_cells : {63, 64}) {
+    const TangentGrid<SO2GroupElement> grid(Vector1d(2 * M_PI / num_cells));
+    EXPECT_EQ(grid.Quantize(SO2GroupElement(0.01)),
+              grid.Quantize(SO2GroupElement(0.02)));
+    EXPECT_NE(grid.Quantize(SO2GroupElement(0.01)),
+              grid.Quantize(SO2GroupElement(-0.01)));
+    // With an odd number of cells, +-pi splits a cell in two, which are
+    // merged. With an even number, it is a boundary between cells.
+    EXPECT_EQ(grid.Quantize(SO2GroupElement(M_PI - 1e-3)) ==
+                  grid.Quantize(SO2GroupElement(-M_PI + 1e-3)),
+              num_cells % 2 == 1);
+    EXPECT_EQ(grid.Quantize(SO2GroupElement(M_PI)),
+              grid.Quantize(SO2GroupElement(-M_PI)));
+
+    // Neighbors across the cell boundary at 0, and across +-pi.
+    for (const double angle : {0.0, M_PI}) {
+      const SO2GroupElement near(angle - 1e-3);
+      const auto far_cell = grid.Quantize(SO2GroupElement(angle + 1e-3));
+      bool found = false;
+      grid.ForEachCell(near, 2e-3, [&](const auto& cell) {
+        found |= cell == far_cell;
+      });
+      EXPECT_TRUE(found);
+    }
+  }
+}
+
+}  // namespace mana
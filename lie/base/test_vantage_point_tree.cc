@@ -0,0 +1,67 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/manifold_array.h"
+#include "lie/base/vantage_point_tree.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+// The generic tree, instantiated on SO2 (with its chordal search metric).
+
+TEST(VantagePointTree, MatchesBruteForce) {
+  std::srand(0);
+  std::vector<SO2GroupElement> elements;
+  for (int i = 0; i < 1000; ++i) {
+    elements.push_back(SO2GroupElement(M_PI * Eigen::Vector2d::Random()(0)));
+  }
+  const VantagePointTree<SO2GroupElement> tree(
+      ManifoldArray<SO2GroupElement>{elements});
+  ASSERT_EQ(tree.size(), elements.size());
+
+  // Compare against brute force search.
+  for (const double angle : {0.0, 1.0, -2.5, M_PI}) {
+    const SO2GroupElement query(angle);
+    std::vector<double> distances;
+    for (const SO2GroupElement& element : elements) {
+      distances.push_back(query.DistanceTo(element));
+    }
+    std::vector<double> sorted = distances;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto nearest = tree.KNearest(query, 10);
+    ASSERT_EQ(nearest.size(), 10);
+    for (size_t k = 0; k < nearest.size(); ++k) {
+      EXPECT_EQ(nearest[k].distance, sorted[k]);
+      EXPECT_EQ(distances[nearest[k].index], nearest[k].distance);
+    }
+
+    // Radii at and just below the distance of an element, which the search
+    // metric may not separate, must be resolved by the exact distance.
+    for (const double radius :
+         {0.05, sorted[20], std::nextafter(sorted[20], 0.0)}) {
+      const auto within = tree.Radius(query, radius);
+      EXPECT_EQ(within.size(),
+                std::upper_bound(sorted.begin(), sorted.end(), radius) -
+                    sorted.begin());
+      for (const auto& neighbor : within) {
+        EXPECT_LE(neighbor.distance, radius);
+        EXPECT_EQ(distances[neighbor.index], neighbor.distance);
+      }
+    }
+  }
+
+  const ManifoldArray<SO2GroupElement> queries(
+      std::vector<SO2GroupElement>{SO2GroupElement(0.5), SO2GroupElement(-1)});
+  const auto batched = tree.KNearest(ParallelExecution{2, 1}, queries, 3);
+  ASSERT_EQ(batched.size(), 2);
+  EXPECT_EQ(batched[1][0].index, tree.KNearest(queries[1], 1)[0].index);
+  EXPECT_TRUE(tree.KNearest(queries[0], 0).empty());
+}
+
+}  // namespace mana
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "lie/base/manifold_array.h"
+#include "lie/base/search_metric.h"
+#include "utils/parallel.h"
+
+namespace mana {
+
+// A vantage-point tree (Yianilos, "Data Structures and Algorithms for Nearest
+// Neighbor Search in General Metric Spaces", SODA 1993) over manifold
+// elements, e.g. rotations or poses for loop closure and place recognition.
+// It answers k-nearest-neighbor and radius queries under `DistanceTo()`,
+// pruning subtrees by the triangle inequality, so queries visit a small part
+// of the tree when the data is well spread.
+//
+// The tree is implicit: its elements are reordered into one `ManifoldArray`,
+// so that each node is a contiguous range whose first element is the node's
+// vantage point, followed by the elements no farther from it than the node's
+// median distance (the inside child), then the rest (the outside child).
+// Ranges of up to `kLeafSize` elements are leaves, scanned in one call to the
+// (vectorizable, see search_metric.h) distance kernel.
+//
+// `T` must be storable in a `ManifoldArray<T>`.
+template <typename T>
+class VantagePointTree {
+ public:
+  using Element = T;
+  using Scalar = typename T::Scalar;
+  using Metric = SearchMetric<T>;
+  static constexpr size_t kLeafSize = 16;
+
+  // A query result: the index of an element in the array the tree was built
+  // from, and its `DistanceTo()` from the query.
+  struct Neighbor {
+    size_t index;
+    Scalar distance;
+  };
+
+  // Build the tree over (a copy of) `elements`, in O(n log n) distances.
+  explicit VantagePointTree(const ManifoldArray<T>& elements);
+
+  // Return the number of elements.
+  size_t size() const;
+  bool empty() const;
+
+  // Return the (up to) `k` elements nearest to `query`, in order of
+  // increasing distance.
+  std::vector<Neighbor> KNearest(const T& query, size_t k) const;
+
+  // Return all elements within `radius` of `query`, in order of increasing
+  // distance.
+  std::vector<Neighbor> Radius(const T& query, Scalar radius) const;
+
+  // Batched `KNearest()`, answering the queries in parallel under `policy`.
+  template <typename Policy>
+  std::vector<std::vector<Neighbor>> KNearest(const Policy& policy,
+                                              const ManifoldArray<T>& queries,
+                                              size_t k) const;
+
+ private:
+  // Collects the `k` nearest elements seen, searching within the distance of
+  // the k-th nearest so far.
+  class NearestCollector;
+  // Collects all elements within a fixed radius.
+  class RadiusCollector;
+
+  // Partition [begin, end) into a subtree, using `distances` as scratch.
+  void Build(size_t begin, size_t end, std::vector<Scalar>& distances);
+
+  // Offer the elements of the subtree [begin, end) within the collector's
+  // current radius to the collector.
+  template <typename Collector>
+  void Search(const T& query, size_t begin, size_t end,
+              Collector& collector) const;
+
+  // Convert (search metric, position) pairs to sorted neighbors, dropping
+  // those farther than `max_distance` by `DistanceTo()`. The search metric
+  // is only monotone in the distance up to rounding, so an element just
+  // outside a radius may pass the metric's test.
+  std::vector<Neighbor> ToNeighbors(
+      const T& query, const std::vector<std::pair<Scalar, size_t>>& found,
+      Scalar max_distance = std::numeric_limits<Scalar>::infinity()) const;
+
+  // The elements in tree order, the index of each in the input array, and
+  // the median distance of each internal node, stored at its vantage point.
+  ManifoldArray<T> elements_;
+  std::vector<size_t> indices_;
+  std::vector<Scalar> thresholds_;
+};
+
+template <typename T>
+class VantagePointTree<T>::NearestCollector {
+ public:
+  explicit NearestCollector(size_t k) : k_(k) {}
+
+  Scalar radius() const {
+    return heap_.size() < k_ ? std::numeric_limits<Scalar>::infinity()
+                             : heap_.top().first;
+  }
+
+  void Add(Scalar distance, size_t position) {
+    if (heap_.size() < k_) {
+      heap_.emplace(distance, position);
+    } else if (distance < heap_.top().first) {
+      heap_.pop();
+      heap_.emplace(distance, position);
+    }
+  }
+
+  std::vector<std::pair<Scalar, size_t>> Release() {
+    std::vector<std::pair<Scalar, size_t>> found;
+    found.reserve(heap_.size());
+    for (; !heap_.empty(); heap_.pop()) found.push_back(heap_.top());
+    return found;
+  }
+
+ private:
+  size_t k_;
+  // A max-heap of the k nearest so far.
+  std::priority_queue<std::pair<Scalar, size_t>> heap_;
+};
+
+template <typename T>
+class VantagePointTree<T>::RadiusCollector {
+ public:
+  explicit RadiusCollector(Scalar radius) : radius_(radius) {}
+
+  Scalar radius() const { return radius_; }
+
+  void Add(Scalar distance, size_t position) {
+    if (distance <= radius_) found_.emplace_back(distance, position);
+  }
+
+  std::vector<std::pair<Scalar, size_t>> Release() {
+    return std::move(found_);
+  }
+
+ private:
+  Scalar radius_;
+  std::vector<std::pair<Scalar, size_t>> found_;
+};
+
+template <typename T>
+VantagePointTree<T>::VantagePointTree(const ManifoldArray<T>& elements)
+    : elements_(elements),
+      indices_(elements.size()),
+      thresholds_(elements.size(), 0) {
+  std::iota(indices_.begin(), indices_.end(), 0);
+  std::vector<Scalar> distances(size());
+  Build(0, size(), distances);
+}
+
+template <typename T>
+size_t VantagePointTree<T>::size() const {
+  return elements_.size();
+}
+
+template <typename T>
+bool VantagePointTree<T>::empty() const {
+  return size() == 0;
+}
+
+template <typename T>
+void VantagePointTree<T>::Build(size_t begin, size_t end,
+                                std::vector<Scalar>& distances) {
+  if (end - begin <= kLeafSize) return;
+
+  // The first element of the range is the vantage point. Partition the rest
+  // about their median distance from it.
+  auto& storage = elements_.storage();
+  Metric::Distances(elements_[begin], storage, begin + 1, end,
+                    distances.data() + begin + 1);
+  std::vector<size_t> order(end - begin - 1);
+  std::iota(order.begin(), order.end(), begin + 1);
+  const size_t mid = begin + 1 + order.size() / 2;
+  std::nth_element(order.begin(), order.begin() + (mid - begin - 1),
+                   order.end(), [&](size_t lhs, size_t rhs) {
+                     return distances[lhs] < distances[rhs];
+                   });
+  thresholds_[begin] = distances[order[mid - begin - 1]];
+
+  // Apply the partition to the elements and their indices.
+  const typename ManifoldArray<T>::Storage columns =
+      storage(Eigen::all, order);
+  storage.middleCols(begin + 1, order.size()) = columns;
+  std::vector<size_t> indices(order.size());
+  for (size_t j = 0; j < order.size(); ++j) indices[j] = indices_[order[j]];
+  std::copy(indices.begin(), indices.end(), indices_.begin() + begin + 1);
+
+  Build(begin + 1, mid, distances);
+  Build(mid, end, distances);
+}
+
+template <typename T>
+template <typename Collector>
+void VantagePointTree<T>::Search(const T& query, size_t begin, size_t end,
+                                 Collector& collector) const {
+  if (end - begin <= kLeafSize) {
+    Scalar distances[kLeafSize];
+    Metric::Distances(query, elements_.storage(), begin, end, distances);
+    for (size_t i = begin; i < end; ++i) {
+      collector.Add(distances[i - begin], i);
+    }
+    return;
+  }
+
+  Scalar distance;
+  Metric::Distances(query, elements_.storage(), begin, begin + 1, &distance);
+  collector.Add(distance, begin);
+
+  // Inside elements are no farther than `threshold` from the vantage point,
+  // and outside elements no nearer, so by the triangle inequality the inside
+  // (outside) child can only hold elements within the radius if
+  // distance - radius <= threshold (distance + radius >= threshold). Search
+  // the child the query falls in first, as it shrinks the radius faster.
+  const size_t mid = begin + 1 + (end - begin - 1) / 2;
+  const Scalar threshold = thresholds_[begin];
+  if (distance <= threshold) {
+    if (distance - collector.radius() <= threshold) {
+      Search(query, begin + 1, mid, collector);
+    }
+    if (distance + collector.radius() >= threshold) {
+      Search(query, mid, end, collector);
+    }
+  } else {
+    if (distance + collector.radius() >= threshold) {
+      Search(query, mid, end, collector);
+    }
+    if (distance - collector.radius() <= threshold) {
+      Search(query, begin + 1, mid, collector);
+    }
+  }
+}
+
+template <typename T>
+std::vector<typename VantagePointTree<T>::Neighbor>
+VantagePointTree<T>::ToNeighbors(
+    const T& query, const std::vector<std::pair<Scalar, size_t>>& found,
+    Scalar max_distance) const {
+  std::vector<Neighbor> neighbors;
+  neighbors.reserve(found.size());
+  for (const auto& [metric_distance, position] : found) {
+    const Scalar distance = query.DistanceTo(elements_[position]);
+    if (distance > max_distance) continue;
+    neighbors.push_back(Neighbor{indices_[position], distance});
+  }
+  std::sort(neighbors.begin(), neighbors.end(),
+            [](const Neighbor& lhs, const Neighbor& rhs) {
+              return lhs.distance < rhs.distance ||
+                     (lhs.distance == rhs.distance && lhs.index < rhs.index);
+            });
+  return neighbors;
+}
+
+template <typename T>
+std::vector<typename VantagePointTree<T>::Neighbor>
+VantagePointTree<T>::KNearest(const T& query, size_t k) const {
+  if (k == 0 || empty()) return {};
+  NearestCollector collector(k);
+  Search(query, 0, size(), collector);
+  return ToNeighbors(query, collector.Release());
+}
+
+template <typename T>
+std::vector<typename VantagePointTree<T>::Neighbor>
+VantagePointTree<T>::Radius(const T& query, Scalar radius) const {
+  if (radius < 0 || empty()) return {};
+  RadiusCollector collector(Metric::FromDistance(radius));
+  Search(query, 0, size(), collector);
+  return ToNeighbors(query, collector.Release(), radius);
+}
+
+template <typename T>
+template <typename Policy>
+std::vector<std::vector<typename VantagePointTree<T>::Neighbor>>
+VantagePointTree<T>::KNearest(const Policy& policy,
+                              const ManifoldArray<T>& queries,
+                              size_t k) const {
+  std::vector<std::vector<Neighbor>> neighbors(queries.size());
+  ParallelFor(policy, queries.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      neighbors[i] = KNearest(queries[i], k);
+    }
+  });
+  return neighbors;
+}
+
+}  // namespace mana
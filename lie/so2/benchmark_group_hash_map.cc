@@ -0,0 +1,74 @@
+// Compares deduplicating headings by pairwise `DistanceTo()` against a
+// `GroupHashMap` over a quantized tangent grid.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "lie/base/group_hash_map.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr size_t kNumElements = 8192;
+constexpr double kTolerance = 1e-3;
+
+void Run() {
+  // Headings on a coarse lattice, with noise below the tolerance, so that
+  // most of them are near-duplicates.
+  std::srand(0);
+  std::vector<SO2GroupElement> elements;
+  for (size_t i = 0; i < kNumElements; ++i) {
+    const double noise = kTolerance / 4 * (2.0 * std::rand() / RAND_MAX - 1);
+    elements.push_back(
+        SO2GroupElement(2 * M_PI * (std::rand() % 2048) / 2048 + noise));
+  }
+
+  size_t num_distinct = 0;
+  const double pairwise =
+      MeasureNanoseconds(
+          [&] {
+            std::vector<SO2GroupElement> distinct;
+            for (const SO2GroupElement& element : elements) {
+              bool duplicate = false;
+              for (const SO2GroupElement& other : distinct) {
+                if (element.DistanceTo(other) <= kTolerance) {
+                  duplicate = true;
+                  break;
+                }
+              }
+              if (!duplicate) distinct.push_back(element);
+            }
+            num_distinct = distinct.size();
+            DoNotOptimize(num_distinct);
+          },
+          2) /
+      kNumElements;
+  const double hash_map =
+      MeasureNanoseconds(
+          [&] {
+            GroupHashMap<SO2GroupElement, size_t> map(
+                SO2GroupElement::TangentVector(2 * M_PI / 4096), kTolerance);
+            for (size_t i = 0; i < elements.size(); ++i) {
+              map.Insert(elements[i], i);
+            }
+            DoNotOptimize(map.size());
+          },
+          20) /
+      kNumElements;
+
+  std::printf("SO2 deduplication of %zu headings (%zu distinct)\n",
+              kNumElements, num_distinct);
+  PrintBenchmark("Pairwise DistanceTo", pairwise, pairwise);
+  PrintBenchmark("GroupHashMap", hash_map, pairwise);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Compares k-nearest-neighbor queries over a million headings by brute force
+// `DistanceTo()` against a vantage-point tree.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "lie/base/manifold_array.h"
+#include "lie/base/vantage_point_tree.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr size_t kNumElements = 1 << 20;
+constexpr size_t kNumQueries = 64;
+constexpr size_t kNearest = 10;
+
+std::vector<SO2GroupElement> RandomElements(size_t size) {
+  std::vector<SO2GroupElement> elements;
+  elements.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    elements.push_back(
+        SO2GroupElement(M_PI * (2.0 * std::rand() / RAND_MAX - 1)));
+  }
+  return elements;
+}
+
+void Run() {
+  std::srand(0);
+  const std::vector<SO2GroupElement> elements = RandomElements(kNumElements);
+  const std::vector<SO2GroupElement> queries = RandomElements(kNumQueries);
+  const VantagePointTree<SO2GroupElement> tree(
+      ManifoldArray<SO2GroupElement>{elements});
+
+  std::vector<std::pair<double, size_t>> distances(kNumElements);
+  const double brute_force =
+      MeasureNanoseconds(
+          [&] {
+            for (const SO2GroupElement& query : queries) {
+              for (size_t i = 0; i < kNumElements; ++i) {
+                distances[i] = {query.DistanceTo(elements[i]), i};
+              }
+              std::partial_sort(distances.begin(),
+                                distances.begin() + kNearest,
+                                distances.end());
+              DoNotOptimize(distances[0]);
+            }
+          },
+          1) /
+      kNumQueries;
+  const double vantage_point_tree =
+      MeasureNanoseconds(
+          [&] {
+            for (const SO2GroupElement& query : queries) {
+              DoNotOptimize(tree.KNearest(query, kNearest));
+            }
+          },
+          100) /
+      kNumQueries;
+
+  std::printf("SO2 %zu-nearest neighbors of %zu elements\n", kNearest,
+              kNumElements);
+  PrintBenchmark("Brute force", brute_force, brute_force);
+  PrintBenchmark("Vantage-point tree", vantage_point_tree, brute_force);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
@@ -0,0 +1,81 @@
+// Compares projecting noisy 2x2 matrices onto SO2 via the SVD against the
+// closed-form projection, one at a time and batched.
+//
+// The speedup depends on the machine and build: with g++ 12 at -O2 -DNDEBUG
+// on a Xeon, the closed form takes 6-9 ns against 110-145 ns for the SVD
+// (12-19x), while other setups have measured 29 ns and 18 ns (batched)
+// against 146 ns (5-8x). Without -DNDEBUG, `FromPoint()` also asserts that
+// each result is a valid rotation.
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+using Matrix = SO2GroupElement::EmbeddingPoint;
+
+constexpr size_t kNumPoints = 1024;
+constexpr size_t kIterations = 2000;
+
+// The SVD-based projection, as previously used by `SO2GroupElement::Project`.
+Matrix ProjectSVD(const Matrix& point) {
+  Eigen::JacobiSVD<Matrix> svd(point,
+                               Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Matrix u = svd.matrixU();
+  if (u.determinant() * svd.matrixV().determinant() < 0) u.col(1) *= -1;
+  return u * svd.matrixV().transpose();
+}
+
+void Run() {
+  std::srand(0);
+  std::vector<Matrix> points;
+  SO2GroupElement::PointBatch batch(4, kNumPoints);
+  for (size_t i = 0; i < kNumPoints; ++i) {
+    const Matrix point = SO2GroupElement(0.01 * i).Point() +
+                         0.05 * Eigen::Matrix2d::Random();
+    points.push_back(point);
+    batch.col(i) = point.reshaped();
+  }
+
+  const double svd = MeasureNanoseconds(
+                         [&] {
+                           for (const Matrix& point : points) {
+                             DoNotOptimize(SO2GroupElement::FromPoint(
+                                 ProjectSVD(point)));
+                           }
+                         },
+                         kIterations) /
+                     kNumPoints;
+  const double closed_form = MeasureNanoseconds(
+                                 [&] {
+                                   for (const Matrix& point : points) {
+                                     DoNotOptimize(SO2GroupElement::FromPoint(
+                                         SO2GroupElement::Project(point)));
+                                   }
+                                 },
+                                 kIterations) /
+                             kNumPoints;
+  const double batched =
+      MeasureNanoseconds(
+          [&] { DoNotOptimize(SO2GroupElement::ProjectBatch(batch)); },
+          kIterations) /
+      kNumPoints;
+
+  std::printf("SO2 projection\n");
+  PrintBenchmark("JacobiSVD", svd, svd);
+  PrintBenchmark("Closed form", closed_form, svd);
+  PrintBenchmark("Closed form, batched", batched, svd);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
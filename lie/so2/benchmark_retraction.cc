@@ -0,0 +1,81 @@
+// Compares the cost of the retractions available to `Plus` and `Minus` (see
+// lie/base/retraction.h) on SO2.
+
+#include <cstdio>
+#include <vector>
+
+#include "lie/base/retraction.h"
+#include "lie/so2/so2_group_element.h"
+#include "utils/benchmark.h"
+
+namespace mana {
+namespace {
+
+constexpr size_t kNumElements = 1024;
+constexpr size_t kIterations = 2000;
+
+template <typename Retraction>
+double BenchmarkPlus(const std::vector<SO2GroupElement>& elements,
+                     const std::vector<SO2GroupElement::TangentVector>& steps) {
+  const double nanoseconds = MeasureNanoseconds(
+      [&] {
+        for (size_t i = 0; i < elements.size(); ++i) {
+          DoNotOptimize(elements[i].Plus<Retraction>(steps[i]));
+        }
+      },
+      kIterations);
+  return nanoseconds / elements.size();
+}
+
+template <typename Retraction>
+double BenchmarkMinus(const std::vector<SO2GroupElement>& elements,
+                      const std::vector<SO2GroupElement>& others) {
+  const double nanoseconds = MeasureNanoseconds(
+      [&] {
+        for (size_t i = 0; i < elements.size(); ++i) {
+          DoNotOptimize(elements[i].Minus<Retraction>(others[i]));
+        }
+      },
+      kIterations);
+  return nanoseconds / elements.size();
+}
+
+void Run() {
+  std::vector<SO2GroupElement> elements;
+  std::vector<SO2GroupElement> others;
+  std::vector<SO2GroupElement::TangentVector> steps;
+  for (size_t i = 0; i < kNumElements; ++i) {
+    const double angle = -3.0 + 6.0 * i / kNumElements;
+    const double step = -0.1 + 0.2 * i / kNumElements;
+    elements.emplace_back(angle);
+    others.emplace_back(angle + step);
+    steps.emplace_back(step);
+  }
+
+  std::printf("SO2 Plus\n");
+  const double exp_plus = BenchmarkPlus<ExpRetraction>(elements, steps);
+  PrintBenchmark("ExpRetraction", exp_plus, exp_plus);
+  PrintBenchmark("CayleyRetraction",
+                 BenchmarkPlus<CayleyRetraction>(elements, steps), exp_plus);
+  PrintBenchmark("FirstOrderRetraction",
+                 BenchmarkPlus<FirstOrderRetraction>(elements, steps),
+                 exp_plus);
+
+  std::printf("SO2 Minus\n");
+  const double exp_minus = BenchmarkMinus<ExpRetraction>(elements, others);
+  PrintBenchmark("ExpRetraction", exp_minus, exp_minus);
+  PrintBenchmark("CayleyRetraction",
+                 BenchmarkMinus<CayleyRetraction>(elements, others),
+                 exp_minus);
+  PrintBenchmark("FirstOrderRetraction",
+                 BenchmarkMinus<FirstOrderRetraction>(elements, others),
+                 exp_minus);
+}
+
+}  // namespace
+}  // namespace mana
+
+int main() {
+  mana::Run();
+  return 0;
+}
@@ -7,7 +7,7 @@
 namespace mana {
 
 so2AlgebraElement::so2AlgebraElement(Scalar angle_radians)
-    : so2AlgebraElement(Vector::Constant(angle_radians)) {}
+    : so2AlgebraElement(Vector(angle_radians)) {}
 
 /*static*/ so2AlgebraElement so2AlgebraElement::FromRadians(
     Scalar angle_radians) {
@@ -28,11 +28,10 @@ so2AlgebraElement::Scalar so2AlgebraElement::AngleDegrees() const {
 }
 
 so2AlgebraElement::so2AlgebraElement(Vector coordinates)
-    : coordinates_(std::move(coordinates)) {}
+    : Base(std::move(coordinates)) {}
 
-so2AlgebraElement::so2AlgebraElement(const Matrix matrix) {
-  coordinates_(0) = matrix(1, 0);
-}
+so2AlgebraElement::so2AlgebraElement(const Matrix& matrix)
+    : so2AlgebraElement(matrix(1, 0)) {}
 
 so2AlgebraElement::Matrix so2AlgebraElement::AsMatrixImpl() const {
   const Scalar angle_radians = AngleRadians();
@@ -1,12 +1,11 @@
 #pragma once
 
 #include "lie/base/lie_algebra_element.h"
-#include "lie/so2/so2_group_element.h"
-#include "so2_group_element.h"
 
 namespace mana {
 
-struct so2AlgebraElement;
+class so2AlgebraElement;
+class SO2GroupElement;
 
 // Specialization of algebra traits for so2.
 template <>
@@ -101,13 +100,14 @@ class so2AlgebraElement : public LieAlgebraElement<so2AlgebraElement> {
    *
    *  so2AlgebraElement Bracket(const so2AlgebraElement& rhs) const;
    *
+   *  template <int Order>
+   *  static so2AlgebraElement BCH(const so2AlgebraElement& a,
+   *                               const so2AlgebraElement& b);
+   *
    *  static so2AlgebraElement log(const SO2GroupElement& group);
    *
    *  SO2GroupElement exp() const;
    */
-
- private:
-  Vector coordinates_;
 };
 
 }  // namespace mana
\ No newline at end of file
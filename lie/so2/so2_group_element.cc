@@ -1,6 +1,8 @@
 #include "lie/so2/so2_group_element.h"
 
-#include "so2_group_element.h"
+#include <algorithm>
+#include <cmath>
+
 #include "utils/angles.h"
 
 namespace mana {
@@ -19,7 +21,7 @@ SO2GroupElement::SO2GroupElement(Scalar angle_radians)
 }
 
 SO2GroupElement::Scalar SO2GroupElement::AngleRadians() const {
-  return std::acos(cos_theta_);
+  return std::atan2(sin_theta_, cos_theta_);
 }
 
 SO2GroupElement::Scalar SO2GroupElement::AngleDegrees() const {
@@ -30,6 +32,69 @@ SO2GroupElement::EmbeddingPoint SO2GroupElement::AsMatrix() const {
   return Point();
 }
 
+/*static*/ SO2GroupElement SO2GroupElement::FromStorage(
+    const Scalar* storage) {
+  return SO2GroupElement(storage[0], storage[1]);
+}
+
+void SO2GroupElement::ToStorage(Scalar* storage) const {
+  storage[0] = cos_theta_;
+  storage[1] = sin_theta_;
+}
+
+/*static*/ std::vector<SO2GroupElement> SO2GroupElement::ProjectBatch(
+    const PointBatch& points) {
+  using Row = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+  // See `ProjectImpl()`.
+  const Row cos_theta = points.row(0).array() + points.row(3).array();
+  const Row sin_theta = points.row(1).array() - points.row(2).array();
+  const Row squared_magnitude = cos_theta.square() + sin_theta.square();
+  const Row inverse_magnitude = squared_magnitude.rsqrt();
+  std::vector<SO2GroupElement> elements;
+  elements.reserve(points.cols());
+  for (Eigen::Index i = 0; i < points.cols(); ++i) {
+    if (squared_magnitude(i) == 0) {
+      elements.push_back(SO2GroupElement());
+    } else {
+      elements.push_back(SO2GroupElement(cos_theta(i) * inverse_magnitude(i),
+                                         sin_theta(i) * inverse_magnitude(i)));
+    }
+  }
+  return elements;
+}
+
+/*static*/ SO2GroupElement SO2GroupElement::ExtrinsicMean(
+    const std::vector<SO2GroupElement>& elements,
+    const std::vector<Scalar>& weights) {
+  assert(weights.empty() || weights.size() == elements.size());
+  Scalar cos_sum = 0;
+  Scalar sin_sum = 0;
+  for (size_t i = 0; i < elements.size(); ++i) {
+    const Scalar weight = weights.empty() ? 1 : weights[i];
+    cos_sum += weight * elements[i].cos_theta_;
+    sin_sum += weight * elements[i].sin_theta_;
+  }
+  const Scalar magnitude = std::sqrt(cos_sum * cos_sum + sin_sum * sin_sum);
+  // Elements that are spread uniformly around the circle have no mean.
+  if (magnitude == 0) return SO2GroupElement();
+  return SO2GroupElement(cos_sum / magnitude, sin_sum / magnitude);
+}
+
+SO2GroupElement SO2GroupElement::ComposeUnnormalized(
+    const SO2GroupElement& rhs) const {
+  // Complex multiplication: (a + bi) * (c + di) = (ac - bd) + (ad + bc)i.
+  // (where a = cos(lhs.t), b = sin(lhs.t), c = cos(rhs.t), d = sin(rhs.t)).
+  return SO2GroupElement(
+      cos_theta_ * rhs.cos_theta_ - sin_theta_ * rhs.sin_theta_,
+      cos_theta_ * rhs.sin_theta_ + sin_theta_ * rhs.cos_theta_);
+}
+
+SO2GroupElement SO2GroupElement::Normalized() const {
+  const Scalar magnitude =
+      std::sqrt(cos_theta_ * cos_theta_ + sin_theta_ * sin_theta_);
+  return SO2GroupElement(cos_theta_ / magnitude, sin_theta_ / magnitude);
+}
+
 /*static*/ SO2GroupElement SO2GroupElement::IdentityImpl() {
   return SO2GroupElement();
 }
@@ -39,16 +104,17 @@ SO2GroupElement SO2GroupElement::InverseImpl() const {
 }
 
 SO2GroupElement SO2GroupElement::ComposeImpl(const SO2GroupElement& rhs) const {
-  // Complex multiplication: (a + bi) * (c + di) = (ac - bd) + (ad + bc)i.
-  // (where a = cos(lhs.t), b = sin(lhs.t), c = cos(rhs.t), d = sin(rhs.t)).
-  Scalar cos_theta = cos_theta_ * rhs.cos_theta_ - sin_theta_ * rhs.sin_theta_;
-  Scalar sin_theta = cos_theta_ * rhs.sin_theta_ - sin_theta_ * rhs.cos_theta_;
-  const Scalar magnitude = cos_theta * cos_theta + sin_theta * sin_theta;
-  if (std::abs(magnitude - 1) >= Constants<Scalar>::kEpsilon) {
-    cos_theta /= magnitude;
-    sin_theta /= magnitude;
+  const SO2GroupElement product = ComposeUnnormalized(rhs);
+  // Check the squared norm, so that the square root is only taken when the
+  // product has drifted enough to need normalizing.
+  const Scalar squared_magnitude = product.cos_theta_ * product.cos_theta_ +
+                                   product.sin_theta_ * product.sin_theta_;
+  if (std::abs(squared_magnitude - 1) >= Constants<Scalar>::kEpsilon) {
+    const Scalar magnitude = std::sqrt(squared_magnitude);
+    return SO2GroupElement(product.cos_theta_ / magnitude,
+                           product.sin_theta_ / magnitude);
   }
-  return SO2GroupElement(cos_theta, sin_theta);
+  return product;
 }
 
 /*static*/ SO2GroupElement SO2GroupElement::FromPointImpl(
@@ -59,14 +125,19 @@ SO2GroupElement SO2GroupElement::ComposeImpl(const SO2GroupElement& rhs) const {
 
 /*static*/ SO2GroupElement::EmbeddingPoint SO2GroupElement::ProjectImpl(
     const EmbeddingPoint& point) {
-  Eigen::JacobiSVD<EmbeddingPoint> svd(
-      point, Eigen::ComputeFullU | Eigen::ComputeFullV);
-  EmbeddingPoint U = svd.matrixU();
-  EmbeddingPoint V = svd.matrixV();
-  if (U.determinant() * V.determinant() < 0) {
-    U.col(1) *= -1;
-  }
-  return (U * V.transpose()).eval();
+  // The rotation closest to M (in the Frobenius norm) maximizes
+  //   tr(R(theta)' M) = cos(theta) (m00 + m11) + sin(theta) (m10 - m01),
+  // so (cos(theta), sin(theta)) is the direction of (m00 + m11, m10 - m01).
+  // This is the rotation factor of M's polar decomposition, without an SVD.
+  const Scalar cos_theta = point(0, 0) + point(1, 1);
+  const Scalar sin_theta = point(1, 0) - point(0, 1);
+  const Scalar magnitude =
+      std::sqrt(cos_theta * cos_theta + sin_theta * sin_theta);
+  // Every rotation is equally close to a (scaled) reflection.
+  if (magnitude == 0) return EmbeddingPoint::Identity();
+  EmbeddingPoint projected;
+  projected << cos_theta, -sin_theta, sin_theta, cos_theta;
+  return projected / magnitude;
 }
 
 /*static*/ bool SO2GroupElement::IsValidImpl(const EmbeddingPoint& point,
@@ -100,10 +171,96 @@ SO2GroupElement::Jacobian SO2GroupElement::AdjointImpl() const {
   return Jacobian::Constant(1);
 }
 
+/*static*/ std::vector<SO2GroupElement> SO2GroupElement::ExpBatchImpl(
+    const TangentBatch& coordinates) {
+  // Evaluate all sines and cosines as (vectorizable) array expressions.
+  const Eigen::Array<Scalar, 1, Eigen::Dynamic> cos_theta =
+      coordinates.array().cos();
+  const Eigen::Array<Scalar, 1, Eigen::Dynamic> sin_theta =
+      coordinates.array().sin();
+  std::vector<SO2GroupElement> elements;
+  elements.reserve(coordinates.cols());
+  for (Eigen::Index i = 0; i < coordinates.cols(); ++i) {
+    elements.push_back(SO2GroupElement(cos_theta(i), sin_theta(i)));
+  }
+  return elements;
+}
+
+/*static*/ SO2GroupElement SO2GroupElement::CayleyImpl(
+    const TangentVector& coordinate) {
+  // With t = theta / 2, the Cayley transform is (1 + it) / (1 - it), i.e. the
+  // rational parameterization of the unit circle.
+  const Scalar t = coordinate(0) / 2;
+  const Scalar t2 = t * t;
+  const Scalar denominator = 1 + t2;
+  return SO2GroupElement((1 - t2) / denominator, 2 * t / denominator);
+}
+
+SO2GroupElement::TangentVector SO2GroupElement::InverseCayleyImpl() const {
+  return TangentVector(2 * sin_theta_ / (1 + cos_theta_));
+}
+
+/*static*/ SO2GroupElement SO2GroupElement::FirstOrderRetractImpl(
+    const TangentVector& coordinate) {
+  const Scalar theta = coordinate(0);
+  const Scalar inverse_norm = 1 / std::sqrt(1 + theta * theta);
+  return SO2GroupElement(inverse_norm, theta * inverse_norm);
+}
+
+SO2GroupElement::TangentVector SO2GroupElement::FirstOrderLocalImpl() const {
+  return TangentVector(sin_theta_ / cos_theta_);
+}
+
 SO2GroupElement::SO2GroupElement(Scalar cos_theta, Scalar sin_theta)
     : cos_theta_(cos_theta), sin_theta_(sin_theta) {
-  assert(std::abs(cos_theta_ * cos_theta_ + sin_theta_ * sin_theta - 1) <
+  assert(std::abs(cos_theta_ * cos_theta_ + sin_theta_ * sin_theta_ - 1) <
          Constants<Scalar>::kEpsilon);
 }
 
-}  // namespace mana
\ No newline at end of file
+/*static*/ void SearchMetric<SO2GroupElement>::Distances(
+    const SO2GroupElement& query, const Storage& storage, size_t begin,
+    size_t end, Scalar* distances) {
+  using Row = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+  assert(begin <= end && end <= static_cast<size_t>(storage.cols()));
+  Scalar coordinates[SO2GroupElement::StorageDimension];
+  query.ToStorage(coordinates);
+  const Eigen::Index size = end - begin;
+  Eigen::Map<Row>(distances, size) =
+      ((storage.row(0).segment(begin, size).array() - coordinates[0]).square() +
+       (storage.row(1).segment(begin, size).array() - coordinates[1]).square())
+          .sqrt();
+}
+
+/*static*/ SearchMetric<SO2GroupElement>::Scalar
+SearchMetric<SO2GroupElement>::FromDistance(Scalar distance) {
+  return 2 * std::sin(std::min<Scalar>(distance, M_PI) / 2);
+}
+
+/*static*/ void ArrayKernels<SO2GroupElement>::Compose(const Storage& lhs,
+                                                        const Storage& rhs,
+                                                        size_t begin,
+                                                        size_t end,
+                                                        Storage& output) {
+  // Work in blocks held on the stack, so that `output` may alias the inputs.
+  constexpr Eigen::Index kBlockSize = 64;
+  using Block =
+      Eigen::Array<Scalar, 1, Eigen::Dynamic, Eigen::RowMajor, 1, kBlockSize>;
+  assert(begin <= end && end <= static_cast<size_t>(lhs.cols()));
+  for (size_t block = begin; block < end; block += kBlockSize) {
+    const Eigen::Index size = std::min<size_t>(kBlockSize, end - block);
+    const auto lhs_cos = lhs.row(0).segment(block, size).array();
+    const auto lhs_sin = lhs.row(1).segment(block, size).array();
+    const auto rhs_cos = rhs.row(0).segment(block, size).array();
+    const auto rhs_sin = rhs.row(1).segment(block, size).array();
+    const Block cos_theta = lhs_cos * rhs_cos - lhs_sin * rhs_sin;
+    const Block sin_theta = lhs_cos * rhs_sin + lhs_sin * rhs_cos;
+    const Block squared_magnitude = cos_theta.square() + sin_theta.square();
+    const Block magnitude =
+        ((squared_magnitude - 1).abs() >= Constants<Scalar>::kEpsilon)
+            .select(squared_magnitude.sqrt(), Scalar(1));
+    output.row(0).segment(block, size).array() = cos_theta / magnitude;
+    output.row(1).segment(block, size).array() = sin_theta / magnitude;
+  }
+}
+
+}  // namespace mana
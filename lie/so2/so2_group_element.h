@@ -1,20 +1,24 @@
 #pragma once
 
+#include <vector>
+
+#include "lie/base/array_kernels.h"
 #include "lie/base/lie_group_element.h"
+#include "lie/base/search_metric.h"
 #include "lie/so2/so2_algebra_element.h"
 
 namespace mana {
 
-struct so2AlgebraElement;
-struct SO2GroupElement;
+class so2AlgebraElement;
+class SO2GroupElement;
 
 // Specialization of manifold traits for SO2.
 template <>
 struct ManifoldTraits<SO2GroupElement> {
   using Element = SO2GroupElement;
   using Scalar = double;
-  using Chart = ManifoldChart<SO2GroupElement>;
-  using Geodesic = ManifoldGeodesic<SO2GroupElement>;
+  using Chart = LieGroupChart<SO2GroupElement>;
+  using Geodesic = LieGroupGeodesic<SO2GroupElement>;
   using TangentVector = Eigen::Vector<Scalar, 1>;      // Angles in R.
   using EmbeddingPoint = Eigen::Matrix<Scalar, 2, 2>;  // 2D rotation matrices.
   static constexpr int Dimension = 1;
@@ -30,6 +34,8 @@ struct LieGroupTraits<SO2GroupElement> {
       Eigen::Matrix<typename ManifoldTraits<SO2GroupElement>::Scalar,
                     ManifoldTraits<SO2GroupElement>::Dimension,
                     ManifoldTraits<SO2GroupElement>::Dimension>;
+  // Planar rotations commute.
+  static constexpr bool IsAbelian = true;
 };
 
 class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
@@ -45,8 +51,13 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
   using GroupElement = typename Base::GroupElement;
   using AlgebraElement = typename Base::AlgebraElement;
   using Jacobian = typename Base::Jacobian;
+  using TangentBatch = typename Base::TangentBatch;
   static constexpr int Dimension = Base::Dimension;
   static constexpr int EmbeddingDimension = Base::EmbeddingDimension;
+  static constexpr bool IsAbelian = Base::IsAbelian;
+  // A batch of points in the embedding space (2x2 matrices), stored
+  // column-wise, each flattened in column-major order: [r00, r10, r01, r11].
+  using PointBatch = Eigen::Matrix<Scalar, EmbeddingDimension, Eigen::Dynamic>;
 
   // Default construct to angle=0.
   SO2GroupElement();
@@ -67,6 +78,38 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
   // Get the rotation matrix for this element (returns a 2x2 matrix).
   EmbeddingPoint AsMatrix() const;
 
+  // Number of scalars in this element's underlying storage, laid out as
+  // [cos(theta), sin(theta)].
+  static constexpr int StorageDimension = 2;
+
+  // Construct from, or copy to, a buffer of `StorageDimension` scalars laid
+  // out as the underlying storage. Assumes the stored values lie on the unit
+  // circle.
+  static SO2GroupElement FromStorage(const Scalar* storage);
+  void ToStorage(Scalar* storage) const;
+
+  // Project a batch of (e.g. noisy) 2x2 matrices onto SO2, returning the
+  // closest rotation to each. Equivalent to `FromPoint(Project(point))` per
+  // column, evaluated as (vectorizable) array expressions.
+  static std::vector<SO2GroupElement> ProjectBatch(const PointBatch& points);
+
+  // The weighted circular mean of `elements`, atan2(sum_i w_i sin(theta_i),
+  // sum_i w_i cos(theta_i)), i.e. the projection of their weighted average
+  // onto the unit circle. Empty `weights` weigh all elements equally. This is
+  // a closed-form approximation of the Karcher mean, and its starting point
+  // in `Mean()` (see lie/base/mean.h).
+  static SO2GroupElement ExtrinsicMean(
+      const std::vector<SO2GroupElement>& elements,
+      const std::vector<Scalar>& weights);
+
+  // Compose without projecting the result back onto the unit circle, and
+  // project onto the unit circle. These let long composition chains normalize
+  // lazily (see `CompositionAccumulator` in lie/base/normalization.h). Plain
+  // `Compose()` still checks the result's norm on every call, and normalizes
+  // it once it drifts by `Constants<>::kEpsilon`.
+  SO2GroupElement ComposeUnnormalized(const SO2GroupElement& rhs) const;
+  SO2GroupElement Normalized() const;
+
   /* The following methods are inherited from `LieGroupElement<>`:
    *
    *  static SO2GroupElement Identity();
@@ -108,8 +151,19 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
    *
    *  static SO2GroupElement Exp(const TangentVector& coordinate);
    *
+   *  static std::vector<SO2GroupElement> ExpBatch(
+   *      const TangentBatch& coordinates);
+   *
    *  Jacobian Adjoint() const;
    *
+   *  static Jacobian RightJacobian(const TangentVector& coordinate);
+   *
+   *  static Jacobian LeftJacobian(const TangentVector& coordinate);
+   *
+   *  static Jacobian RightJacobianInverse(const TangentVector& coordinate);
+   *
+   *  static Jacobian LeftJacobianInverse(const TangentVector& coordinate);
+   *
    *  SO2GroupElement rplus(const AlgebraElement& rhs) const;
    *
    *  SO2GroupElement lplus(const AlgebraElement& rhs) const;
@@ -120,7 +174,11 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
    *
    *  SO2GroupElement Lplus(const TangentVector& rhs) const;
    *
+   *  template <typename Retraction = ExpRetraction>
    *  SO2GroupElement Plus(const TangentVector& rhs) const;
+   *
+   *  template <typename Retraction = ExpRetraction>
+   *  TangentVector Minus(const SO2GroupElement& rhs) const;
    */
 
   // --------------------------------------------------------------------------
@@ -139,6 +197,16 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
   TangentVector LogImpl() const;
   static SO2GroupElement ExpImpl(const TangentVector& coordinate);
   Jacobian AdjointImpl() const;
+  static std::vector<SO2GroupElement> ExpBatchImpl(
+      const TangentBatch& coordinates);
+
+  // Closed-form retractions (see retraction.h), free of trigonometric
+  // functions. The first-order retraction normalizes (1, theta) onto the unit
+  // circle, and its local inverse is the exact inverse tan(angle).
+  static SO2GroupElement CayleyImpl(const TangentVector& coordinate);
+  TangentVector InverseCayleyImpl() const;
+  static SO2GroupElement FirstOrderRetractImpl(const TangentVector& coordinate);
+  TangentVector FirstOrderLocalImpl() const;
 
  private:
   // Private ctor assumes c^2 + s^2 = 1.
@@ -151,4 +219,31 @@ class SO2GroupElement : public LieGroupElement<SO2GroupElement> {
   Scalar cos_theta_, sin_theta_;
 };
 
+// Search SO2 by the chordal distance between unit vectors (cos, sin),
+// 2 sin(theta / 2) for a geodesic distance theta in [0, pi]: a metric that is
+// increasing in theta, and is evaluated over storage without trigonometry.
+template <>
+struct SearchMetric<SO2GroupElement> {
+  using Scalar = SO2GroupElement::Scalar;
+  using Storage = Eigen::Matrix<Scalar, SO2GroupElement::StorageDimension,
+                                Eigen::Dynamic, Eigen::RowMajor>;
+
+  static void Distances(const SO2GroupElement& query, const Storage& storage,
+                        size_t begin, size_t end, Scalar* distances);
+  static Scalar FromDistance(Scalar distance);
+};
+
+// Compose SO2 arrays as complex products over the (cos, sin) rows, with the
+// same conditional normalization as `Compose()`, expressed as a select so
+// that it vectorizes.
+template <>
+struct ArrayKernels<SO2GroupElement> {
+  using Scalar = SO2GroupElement::Scalar;
+  using Storage = Eigen::Matrix<Scalar, SO2GroupElement::StorageDimension,
+                                Eigen::Dynamic, Eigen::RowMajor>;
+
+  static void Compose(const Storage& lhs, const Storage& rhs, size_t begin,
+                      size_t end, Storage& output);
+};
+
 }  // namespace mana
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/constants.h"
+#include "lie/base/manifold_array.h"
+#include "lie/base/map.h"
+#include "lie/base/normalization.h"
+#include "lie/so2/so2_algebra_element.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+using EigenStorage = Eigen::Vector<double, SO2GroupElement::StorageDimension>;
+
+TEST(SO2GroupElement, Compose) {
+  const SO2GroupElement a(0.3);
+  const SO2GroupElement b(-1.2);
+  EXPECT_NEAR(a.Compose(b).AngleRadians(), -0.9, Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Compose(a.Inverse()).AngleRadians(), 0,
+              Constants<double>::kEpsilon);
+}
+
+TEST(SO2GroupElement, ExpLog) {
+  for (double angle = -3.1; angle < 3.1; angle += 0.1) {
+    EXPECT_NEAR(SO2GroupElement::Exp(Vector1d(angle)).Log()(0), angle,
+                Constants<double>::kEpsilon);
+  }
+}
+
+TEST(SO2GroupElement, Abelian) {
+  static_assert(SO2GroupElement::IsAbelian);
+  const SO2GroupElement a(0.3);
+  const SO2GroupElement b(2.5);
+  EXPECT_EQ(a.Compose(b), b.Compose(a));
+  EXPECT_EQ(a.Adjoint()(0, 0), 1);
+  EXPECT_EQ(a.Lplus(Vector1d(0.4)), a.Rplus(Vector1d(0.4)));
+  EXPECT_NEAR(a.Lminus(b)(0), a.Rminus(b)(0), Constants<double>::kEpsilon);
+
+  const so2AlgebraElement x(0.3);
+  const so2AlgebraElement y(-0.8);
+  EXPECT_EQ(x.Bracket(y).Vee()(0), 0);
+  EXPECT_EQ(so2AlgebraElement::BCH<4>(x, y), x + y);
+}
+
+TEST(SO2GroupElement, GeodesicSampleUniform) {
+  const SO2GroupElement a(0.3);
+  const SO2GroupElement b(2.9);
+  const SO2GroupElement::Geodesic geodesic = a.GeodesicTo(b);
+  const std::vector<SO2GroupElement> samples =
+      geodesic.SampleUniform(/*beg_fraction=*/-0.5, /*step=*/1e-3, 2000);
+  ASSERT_EQ(samples.size(), 2000);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const SO2GroupElement expected = a.Rplus((-0.5 + i * 1e-3) * a.Rminus(b));
+    EXPECT_LT(samples[i].DistanceTo(expected), 1e-12);
+  }
+}
+
+TEST(SO2GroupElement, Interpolate) {
+  const SO2GroupElement a(0.3);
+  const SO2GroupElement b(1.1);
+  EXPECT_NEAR(a.Interpolate(b, 0.5).AngleRadians(), 0.7,
+              Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Interpolate(b, 0).AngleRadians(), 0.3,
+              Constants<double>::kEpsilon);
+}
+
+TEST(SO2GroupElement, GeodesicInterpolateBatch) {
+  const SO2GroupElement a(-2.8);
+  const SO2GroupElement b(2.9);
+  const SO2GroupElement::Geodesic geodesic = a.GeodesicTo(b);
+  EXPECT_NEAR(geodesic.Tangent()(0), a.Rminus(b)(0),
+              Constants<double>::kEpsilon);
+  EXPECT_NEAR(geodesic.Length(), a.DistanceTo(b), Constants<double>::kEpsilon);
+
+  const std::vector<double> fractions = {-0.5, 0, 0.25, 0.5, 1, 1.7};
+  const std::vector<SO2GroupElement> points = geodesic.Interpolate(fractions);
+  ASSERT_EQ(points.size(), fractions.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_LT(points[i].DistanceTo(geodesic.Interpolate(fractions[i])), 1e-12);
+  }
+  EXPECT_LT(points[1].DistanceTo(a), 1e-12);
+  EXPECT_LT(points[4].DistanceTo(b), 1e-12);
+}
+
+TEST(SO2GroupElement, Chart) {
+  const SO2GroupElement origin(2.9);
+  const SO2GroupElement::Chart chart = origin.LocalChart();
+  const SO2GroupElement x(-3.0);
+  EXPECT_NEAR(chart.ToTangent(x)(0), origin.Rminus(x)(0),
+              Constants<double>::kEpsilon);
+  EXPECT_LT(chart.ToManifold(Vector1d(0.4)).DistanceTo(
+                origin.Rplus(Vector1d(0.4))),
+            1e-12);
+  EXPECT_LT(chart.ToManifold(chart.ToTangent(x)).DistanceTo(x), 1e-12);
+
+  std::vector<SO2GroupElement> elements;
+  for (double angle = -3.1; angle < 3.1; angle += 0.1) {
+    elements.emplace_back(angle);
+  }
+  const SO2GroupElement::TangentBatch coordinates = chart.ToTangent(elements);
+  ASSERT_EQ(coordinates.cols(), elements.size());
+  const std::vector<SO2GroupElement> mapped = chart.ToManifold(coordinates);
+  ASSERT_EQ(mapped.size(), elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    EXPECT_NEAR(coordinates(0, i), chart.ToTangent(elements[i])(0),
+                Constants<double>::kEpsilon);
+    EXPECT_LT(mapped[i].DistanceTo(elements[i]), 1e-12);
+  }
+}
+
+template <typename Retraction>
+void CheckRetraction(double order) {
+  const SO2GroupElement x(2.5);
+  for (double angle = -1.5; angle < 1.5; angle += 0.1) {
+    const Vector1d v(angle);
+    const SO2GroupElement y = x.Plus<Retraction>(v);
+    EXPECT_NEAR(x.Minus<Retraction>(y)(0), angle, 1e-12);
+    // Agrees with the exact map to `order`, with unit constant.
+    EXPECT_LT(y.DistanceTo(x.Rplus(v)),
+              std::pow(std::abs(angle), order) + 1e-15);
+  }
+}
+
+TEST(SO2GroupElement, Retractions) {
+  CheckRetraction<ExpRetraction>(/*order=*/8);
+  CheckRetraction<CayleyRetraction>(/*order=*/3);
+  CheckRetraction<FirstOrderRetraction>(/*order=*/3);
+
+  // The closed forms match the generic, matrix-based implementations.
+  using Generic = LieGroupElement<SO2GroupElement>;
+  const SO2GroupElement x(0.7);
+  const Vector1d v(0.3);
+  EXPECT_LT(SO2GroupElement::CayleyImpl(v).DistanceTo(Generic::CayleyImpl(v)),
+            1e-12);
+  EXPECT_NEAR(x.InverseCayleyImpl()(0), x.Generic::InverseCayleyImpl()(0),
+              1e-12);
+  EXPECT_LT(SO2GroupElement::FirstOrderRetractImpl(v).DistanceTo(
+                Generic::FirstOrderRetractImpl(v)),
+            1e-12);
+  EXPECT_NEAR(x.FirstOrderLocalImpl()(0), x.Generic::FirstOrderLocalImpl()(0),
+              1e-12);
+
+  // The generic first-order local map inverts the generic retraction.
+  for (double angle = -1.5; angle < 1.5; angle += 0.1) {
+    const SO2GroupElement y = Generic::FirstOrderRetractImpl(Vector1d(angle));
+    EXPECT_NEAR(y.Generic::FirstOrderLocalImpl()(0), angle, 1e-12);
+  }
+}
+
+template <typename Normalization>
+void CheckAccumulator(Normalization normalization,
+                      size_t expected_num_normalizations) {
+  constexpr size_t kNumSteps = 10000;
+  const SO2GroupElement step(1e-3);
+  CompositionAccumulator<SO2GroupElement, Normalization> accumulator(
+      SO2GroupElement(0.5), normalization);
+  for (size_t i = 0; i < kNumSteps; ++i) accumulator.Compose(step);
+  EXPECT_EQ(accumulator.NumNormalizations(), expected_num_normalizations);
+  EXPECT_LT(accumulator.value().DistanceTo(SO2GroupElement(0.5 + 10)), 1e-10);
+
+  EigenStorage storage;
+  accumulator.value().ToStorage(storage.data());
+  EXPECT_LE(std::abs(storage.norm() - 1), accumulator.DriftBound());
+}
+
+TEST(SO2GroupElement, CompositionAccumulator) {
+  CheckAccumulator(AlwaysNormalize{}, 10000);
+  CheckAccumulator(NormalizeEvery<100>{}, 100);
+
+  // The drift bound starts at `kDriftAfterNormalization` and grows by
+  // `kDriftPerComposition` per step, so it first exceeds the tolerance after
+  // `period` steps, and is then reset.
+  using Accumulator = CompositionAccumulator<SO2GroupElement, NormalizeOnDrift>;
+  constexpr double kTolerance = 1e-12;
+  const size_t period =
+      std::floor((kTolerance - Accumulator::kDriftAfterNormalization) /
+                 Accumulator::kDriftPerComposition) +
+      1;
+  CheckAccumulator(NormalizeOnDrift{kTolerance}, 10000 / period);
+}
+
+// The reference projection onto SO2, via the SVD.
+SO2GroupElement::EmbeddingPoint ProjectSVD(
+    const SO2GroupElement::EmbeddingPoint& point) {
+  using Matrix = SO2GroupElement::EmbeddingPoint;
+  Eigen::JacobiSVD<Matrix> svd(point,
+                               Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Matrix u = svd.matrixU();
+  if (u.determinant() * svd.matrixV().determinant() < 0) u.col(1) *= -1;
+  return u * svd.matrixV().transpose();
+}
+
+TEST(SO2GroupElement, Project) {
+  std::srand(0);
+  SO2GroupElement::PointBatch points(4, 100);
+  for (Eigen::Index i = 0; i < points.cols(); ++i) {
+    // Noisy rotations, and some arbitrary matrices (including reflections).
+    SO2GroupElement::EmbeddingPoint point =
+        i % 2 == 0 ? SO2GroupElement(0.1 * i).Point() : Eigen::Matrix2d::Zero();
+    point += Eigen::Matrix2d::Random() * (i % 4 < 2 ? 0.05 : 1.0);
+    points.col(i) = point.reshaped();
+
+    const SO2GroupElement::EmbeddingPoint projected =
+        SO2GroupElement::Project(point);
+    EXPECT_TRUE(SO2GroupElement::IsValid(projected));
+    EXPECT_TRUE(projected.isApprox(ProjectSVD(point), 1e-12));
+  }
+
+  const std::vector<SO2GroupElement> elements =
+      SO2GroupElement::ProjectBatch(points);
+  ASSERT_EQ(elements.size(), points.cols());
+  for (Eigen::Index i = 0; i < points.cols(); ++i) {
+    const Eigen::Matrix2d point = points.col(i).reshaped(2, 2);
+    EXPECT_TRUE(elements[i].Point().isApprox(SO2GroupElement::Project(point),
+                                             1e-12));
+  }
+
+  // Reflections have no unique closest rotation; the identity is returned.
+  Eigen::Matrix2d reflection;
+  reflection << 1, 0, 0, -1;
+  EXPECT_EQ(SO2GroupElement::Project(reflection), Eigen::Matrix2d::Identity());
+}
+
+TEST(SO2GroupElement, Map) {
+  // Two packed elements, [cos(a), sin(a), cos(b), sin(b)].
+  double buffer[4];
+  SO2GroupElement(0.3).ToStorage(buffer);
+  SO2GroupElement(-1.2).ToStorage(buffer + 2);
+
+  const Map<const SO2GroupElement> a(buffer);
+  Map<SO2GroupElement> b(buffer + 2);
+  EXPECT_EQ(a.data(), buffer);
+  EXPECT_NEAR(a.Log()(0), 0.3, Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Compose(b).AngleRadians(), -0.9, Constants<double>::kEpsilon);
+  EXPECT_NEAR(b.Inverse().AngleRadians(), 1.2, Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Rminus(b)(0), -1.5, Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Plus(Vector1d(0.1)).AngleRadians(), 0.4,
+              Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.DistanceTo(b), 1.5, Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.Interpolate(b, 0.5).AngleRadians(), -0.45,
+              Constants<double>::kEpsilon);
+  EXPECT_NEAR(a.GeodesicTo(b).Length(), 1.5, Constants<double>::kEpsilon);
+  EXPECT_TRUE(a.Point().isApprox(SO2GroupElement(0.3).Point()));
+  EXPECT_TRUE(a == SO2GroupElement(0.3));
+
+  // Assignment writes through to the buffer.
+  b = b.Compose(SO2GroupElement(0.2));
+  EXPECT_NEAR(SO2GroupElement::FromStorage(buffer + 2).AngleRadians(), -1.0,
+              Constants<double>::kEpsilon);
+  b = a;
+  EXPECT_EQ(buffer[2], buffer[0]);
+  EXPECT_EQ(buffer[3], buffer[1]);
+}
+
+TEST(SO2GroupElement, ManifoldArray) {
+  constexpr size_t kSize = 5000;
+  std::vector<SO2GroupElement> elements;
+  for (size_t i = 0; i < kSize; ++i) elements.emplace_back(1e-3 * i);
+  const ManifoldArray<SO2GroupElement> array(elements);
+  ASSERT_EQ(array.size(), kSize);
+  EXPECT_EQ(array.storage().rows(), SO2GroupElement::StorageDimension);
+  EXPECT_NEAR(array[1234].AngleRadians(), 1.234, Constants<double>::kEpsilon);
+
+  const ParallelExecution parallel{/*num_threads=*/4, /*grain_size=*/256};
+  ManifoldArray<SO2GroupElement> inverses(kSize);
+  Transform(parallel, array, inverses,
+            [](const SO2GroupElement& x) { return x.Inverse(); });
+  ManifoldArray<SO2GroupElement> identities(kSize);
+  Compose(parallel, array, inverses, identities);
+
+  const SO2GroupElement::TangentBatch logs = Log(parallel, array);
+  const SO2GroupElement::TangentBatch zeros = Log(parallel, identities);
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_NEAR(logs(0, i), array[i].Log()(0), Constants<double>::kEpsilon);
+    EXPECT_NEAR(zeros(0, i), 0, Constants<double>::kEpsilon);
+  }
+
+  // The vectorized kernel matches element-wise composition (up to contraction
+  // into fused multiply-adds), also for elements that have drifted off the
+  // unit circle within the validity check, and may compose in place.
+  ManifoldArray<SO2GroupElement> drifted = array;
+  for (size_t i = 0; i < kSize; i += 2) {
+    drifted.storage().col(i) *= 1 + 0.2 * Constants<double>::kEpsilon;
+  }
+  ManifoldArray<SO2GroupElement> squares = drifted;
+  Compose(parallel, squares, drifted, squares);
+  for (size_t i = 0; i < kSize; ++i) {
+    double expected[SO2GroupElement::StorageDimension];
+    drifted[i].Compose(drifted[i]).ToStorage(expected);
+    EXPECT_NEAR(squares.storage()(0, i), expected[0], 1e-15);
+    EXPECT_NEAR(squares.storage()(1, i), expected[1], 1e-15);
+  }
+
+  const auto compose = [](const SO2GroupElement& lhs,
+                          const SO2GroupElement& rhs) {
+    return lhs.Compose(rhs);
+  };
+  const SO2GroupElement product =
+      Reduce(parallel, array, SO2GroupElement(), compose);
+  const SO2GroupElement sequential_product = Reduce(
+      SequentialExecution{/*grain_size=*/256}, array, SO2GroupElement(),
+      compose);
+  EXPECT_EQ(product.Log()(0), sequential_product.Log()(0));
+  // sum_i 1e-3 * i = 1e-3 * n (n - 1) / 2.
+  EXPECT_LT(product.DistanceTo(SO2GroupElement(1e-3 * kSize * (kSize - 1) / 2)),
+            1e-9);
+}
+
+TEST(SO2GroupElement, SearchMetric) {
+  using Metric = SearchMetric<SO2GroupElement>;
+  const ManifoldArray<SO2GroupElement> elements(std::vector<SO2GroupElement>{
+      SO2GroupElement(0.3), SO2GroupElement(-2.0), SO2GroupElement(3.1)});
+  const SO2GroupElement query(2.9);
+  double distances[3];
+  Metric::Distances(query, elements.storage(), 0, 3, distances);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(distances[i],
+                Metric::FromDistance(query.DistanceTo(elements[i])), 1e-12);
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "spline/spline.h"
+
+namespace mana {
+
+// A cubic Hermite spline that can be queried from many threads while a single
+// writer thread (e.g. an estimator) publishes new solutions.
+//
+// Knots are double-buffered. Readers always evaluate a complete, immutable
+// snapshot: they never block, never take a mutex, and never observe a partially
+// written solution. The writer fills the inactive buffer and publishes it with
+// a single atomic store, after waiting for any readers still holding that
+// buffer from two publications ago to finish.
+//
+// Only one thread may call `Publish()` at a time.
+template <typename Group>
+class ConcurrentSpline {
+ public:
+  using Scalar = typename Group::Scalar;
+  using Spline = CubicHermiteSpline<Group>;
+
+  ConcurrentSpline() = default;
+
+  // Publish a new solution, incrementing the version. Copying into the
+  // inactive buffer reuses its storage, so steady-state publications with a
+  // non-increasing number of knots do not allocate.
+  void Publish(const Spline& spline);
+
+  // Evaluate the latest published solution at `time`. If `version` is
+  // provided, it is set to the version of the solution that was evaluated.
+  Group At(Scalar time, uint64_t* version = nullptr) const;
+
+  // Invoke `fn(const Spline&, uint64_t version)` on a consistent snapshot of
+  // the latest published solution, and return its result. Use this to run
+  // several queries against the same version.
+  template <typename Fn>
+  auto Read(Fn&& fn) const;
+
+  // Return the version of the latest published solution (0 if nothing has
+  // been published yet).
+  uint64_t Version() const;
+
+ private:
+  // Acquire the active buffer for reading, returning its index.
+  int AcquireActive() const;
+
+  // One buffer of knots, and the version of the solution it holds.
+  struct Buffer {
+    Spline spline;
+    uint64_t version = 0;
+  };
+
+  Buffer buffers_[2];
+  // Index of the buffer readers should use.
+  std::atomic<int> active_{0};
+  // Number of readers currently holding each buffer.
+  mutable std::atomic<int> readers_[2] = {0, 0};
+};
+
+template <typename Group>
+void ConcurrentSpline<Group>::Publish(const Spline& spline) {
+  const int active = active_.load();
+  const int inactive = 1 - active;
+
+  // Readers that acquired the inactive buffer before the previous publication
+  // may still be using it. New readers cannot acquire it until we flip
+  // `active_` (see AcquireActive()), so this wait is bounded.
+  while (readers_[inactive].load() != 0) {
+    std::this_thread::yield();
+  }
+
+  Buffer& buffer = buffers_[inactive];
+  buffer.spline = spline;
+  buffer.version = buffers_[active].version + 1;
+  active_.store(inactive);
+}
+
+template <typename Group>
+Group ConcurrentSpline<Group>::At(Scalar time, uint64_t* version) const {
+  return Read([&](const Spline& spline, uint64_t snapshot_version) {
+    if (version != nullptr) *version = snapshot_version;
+    return spline.At(time);
+  });
+}
+
+template <typename Group>
+template <typename Fn>
+auto ConcurrentSpline<Group>::Read(Fn&& fn) const {
+  const int index = AcquireActive();
+  const Buffer& buffer = buffers_[index];
+  // Release the buffer even though `fn` returns a value.
+  struct Release {
+    std::atomic<int>& readers;
+    ~Release() { readers.fetch_sub(1); }
+  } release{readers_[index]};
+  return std::forward<Fn>(fn)(buffer.spline, buffer.version);
+}
+
+template <typename Group>
+uint64_t ConcurrentSpline<Group>::Version() const {
+  return Read([](const Spline&, uint64_t version) { return version; });
+}
+
+template <typename Group>
+int ConcurrentSpline<Group>::AcquireActive() const {
+  for (;;) {
+    const int index = active_.load();
+    readers_[index].fetch_add(1);
+    // If the buffer is still active after registering as a reader, the writer
+    // cannot start overwriting it until we release it. Otherwise, the writer
+    // may have flipped buffers in between; back off and retry.
+    if (active_.load() == index) return index;
+    readers_[index].fetch_sub(1);
+  }
+}
+
+}  // namespace mana
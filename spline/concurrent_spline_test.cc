@@ -0,0 +1,69 @@
+#include "spline/concurrent_spline.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+#include "spline/spline.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+// Build a spline whose value is constant, and uniquely identifies `version`.
+CubicHermiteSpline<SO2GroupElement> MakeSpline(uint64_t version) {
+  CubicHermiteSpline<SO2GroupElement> spline;
+  for (int i = 0; i < 10; ++i) {
+    spline.AddKnot(i, SO2GroupElement(1e-3 * version), Vector1d(0));
+  }
+  return spline;
+}
+
+TEST(ConcurrentSpline, Publish) {
+  ConcurrentSpline<SO2GroupElement> spline;
+  EXPECT_EQ(spline.Version(), 0);
+  spline.Publish(MakeSpline(1));
+  EXPECT_EQ(spline.Version(), 1);
+  spline.Publish(MakeSpline(2));
+  EXPECT_EQ(spline.Version(), 2);
+
+  uint64_t version = 0;
+  EXPECT_EQ(spline.At(4.5, &version), SO2GroupElement(2e-3));
+  EXPECT_EQ(version, 2);
+}
+
+TEST(ConcurrentSpline, ReadersSeeConsistentSnapshots) {
+  constexpr uint64_t kNumVersions = 2000;
+  ConcurrentSpline<SO2GroupElement> spline;
+  spline.Publish(MakeSpline(1));
+
+  std::atomic<bool> done = false;
+  std::atomic<int> num_errors = 0;
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      uint64_t last_version = 0;
+      while (!done.load()) {
+        uint64_t version = 0;
+        const SO2GroupElement value = spline.At(3.7, &version);
+        // Every query must see a complete solution, and versions must never
+        // go backwards.
+        if (value != SO2GroupElement(1e-3 * version)) ++num_errors;
+        if (version < last_version) ++num_errors;
+        last_version = version;
+      }
+    });
+  }
+  for (uint64_t version = 2; version <= kNumVersions; ++version) {
+    spline.Publish(MakeSpline(version));
+  }
+  done = true;
+  for (std::thread& reader : readers) reader.join();
+
+  EXPECT_EQ(num_errors.load(), 0);
+  EXPECT_EQ(spline.Version(), kNumVersions);
+}
+
+}  // namespace mana
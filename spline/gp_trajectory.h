@@ -0,0 +1,295 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "spline/spline.h"
+#include "utils/block_tridiagonal.h"
+
+namespace mana {
+
+// A state of a Gaussian-process trajectory: a Lie group element with its
+// body-frame velocity and acceleration.
+template <typename Group>
+struct GPState {
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+
+  Scalar time;
+  Group value;
+  TangentVector velocity;
+  TangentVector acceleration;
+};
+
+// A continuous-time trajectory with a white-noise-on-jerk (WNOJ) Gaussian
+// process motion prior, following Barfoot's "State Estimation for Robotics"
+// (Sec. 11.3) and Tang et al., "A White-Noise-on-Jerk Motion Prior for
+// Continuous-Time Trajectory Estimation on SE(3)".
+//
+// Between consecutive states k and k + 1, the trajectory is expressed in local
+// variables xi(t) = Log(X_k^{-1} X(t)), whose jerk is white noise with power
+// spectral density Qc. The local state gamma = [xi; xi'; xi''] is stacked
+// derivative-major: [xi_0..xi_{D-1}, xi'_0.., xi''_0..]. As is common, we take
+// the local velocity and acceleration to be the body-frame velocity and
+// acceleration of the states (i.e. the inverse left Jacobian of Log is
+// approximated by the identity), which is accurate for small inter-state
+// motions.
+//
+// Two properties make this a sparse model:
+// - Each prior factor only involves two consecutive states, so the prior's
+//   information matrix is exactly block tridiagonal.
+// - The posterior mean at any time only depends on the two states bracketing
+//   that time (see `At()`).
+template <typename Group>
+class GPTrajectory {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using State = GPState<Group>;
+  static constexpr int Dimension = Group::Dimension;
+  static constexpr int StateDimension = 3 * Dimension;
+  using StateVector = Eigen::Matrix<Scalar, StateDimension, 1>;
+  using StateMatrix = Eigen::Matrix<Scalar, StateDimension, StateDimension>;
+  using InformationMatrix = BlockTridiagonalMatrix<Scalar, StateDimension>;
+
+  // Construct from the (diagonal) power spectral density of the white noise on
+  // jerk, per tangent space coordinate.
+  explicit GPTrajectory(TangentVector power_spectral_density);
+
+  // Append a state. State times must be strictly increasing.
+  void AddState(Scalar time, Group value, TangentVector velocity,
+                TangentVector acceleration);
+
+  // Evaluate the posterior mean at the provided time, which must lie within
+  // [BeginTime(), EndTime()]. Only the two states bracketing `time` are used.
+  Group At(Scalar time) const;
+
+  // The prior factor between states k and k + 1:
+  //   e_k = gamma_k(t_{k+1}) - Phi(t_{k+1}, t_k) * gamma_k(t_k),
+  // with information matrix Q_k^{-1}.
+  StateVector PriorError(size_t k) const;
+  StateMatrix PriorInformation(size_t k) const;
+
+  // The prior cost, sum_k e_k' Q_k^{-1} e_k / 2.
+  Scalar PriorCost() const;
+
+  // The prior's information matrix with respect to perturbations of each
+  // state's local variables, sum_k E_k' Q_k^{-1} E_k where E_k = [-Phi, I].
+  // This is block tridiagonal by construction, and can be added to the normal
+  // equations of a trajectory estimation problem and solved in linear time.
+  InformationMatrix PriorInformationMatrix() const;
+
+  // Return the time range spanned by the states.
+  Scalar BeginTime() const;
+  Scalar EndTime() const;
+
+  // Return the number of states.
+  size_t NumStates() const;
+
+  // Access the underlying states.
+  const std::vector<State>& states() const;
+  std::vector<State>& states();
+
+  // Return the power spectral density of the white noise on jerk.
+  const TangentVector& PowerSpectralDensity() const;
+
+  // Per-coordinate (3 x 3) transition matrix Phi(dt) and process noise
+  // covariance Q(dt) (without the Qc factor) of a WNOJ process over `dt`.
+  static Eigen::Matrix<Scalar, 3, 3> Transition(Scalar dt);
+  static Eigen::Matrix<Scalar, 3, 3> ProcessCovariance(Scalar dt);
+
+ private:
+  // Expand a per-coordinate 3 x 3 matrix into a full state matrix, scaling
+  // coordinate d by `scale(d)`.
+  static StateMatrix Expand(const Eigen::Matrix<Scalar, 3, 3>& matrix,
+                            const TangentVector& scale);
+
+  // The local state of `state` in the local variables of `origin`.
+  static StateVector LocalState(const State& origin, const State& state);
+
+  TangentVector power_spectral_density_;
+  std::vector<State> states_;
+};
+
+template <typename Group>
+GPTrajectory<Group>::GPTrajectory(TangentVector power_spectral_density)
+    : power_spectral_density_(std::move(power_spectral_density)) {
+  assert((power_spectral_density_.array() > 0).all());
+}
+
+template <typename Group>
+void GPTrajectory<Group>::AddState(Scalar time, Group value,
+                                   TangentVector velocity,
+                                   TangentVector acceleration) {
+  assert(states_.empty() || time > states_.back().time);
+  states_.push_back(State{time, std::move(value), std::move(velocity),
+                          std::move(acceleration)});
+}
+
+template <typename Group>
+Group GPTrajectory<Group>::At(Scalar time) const {
+  using Matrix3 = Eigen::Matrix<Scalar, 3, 3>;
+  assert(!states_.empty());
+  assert(time >= BeginTime() && time <= EndTime());
+  if (states_.size() == 1) return states_.front().value;
+
+  const size_t k = FindSegment(states_, time);
+  const State& beg = states_[k];
+  const State& end = states_[k + 1];
+  const Scalar dt = end.time - beg.time;
+  const Scalar tau = time - beg.time;
+
+  // Interpolation matrices (Barfoot Eq. 11.38). With a Kronecker-structured
+  // prior Qc cancels out, so these are per-coordinate 3 x 3 matrices.
+  //   Psi    = Q(tau) Phi(dt - tau)' Q(dt)^{-1}
+  //   Lambda = Phi(tau) - Psi Phi(dt)
+  const Matrix3 psi = ProcessCovariance(tau) *
+                      Transition(dt - tau).transpose() *
+                      ProcessCovariance(dt).inverse();
+  const Matrix3 lambda = Transition(tau) - psi * Transition(dt);
+
+  // Local state at `beg` is [0; v_k; a_k], local state at `end` is
+  // [Log(X_k^{-1} X_{k+1}); v_{k+1}; a_{k+1}]. Only the pose row is needed.
+  const TangentVector xi =
+      lambda(0, 1) * beg.velocity + lambda(0, 2) * beg.acceleration +
+      psi(0, 0) * beg.value.Rminus(end.value) + psi(0, 1) * end.velocity +
+      psi(0, 2) * end.acceleration;
+  return beg.value.Rplus(xi);
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::StateVector GPTrajectory<Group>::PriorError(
+    size_t k) const {
+  assert(k + 1 < states_.size());
+  const State& beg = states_[k];
+  const State& end = states_[k + 1];
+  const StateMatrix transition = Expand(Transition(end.time - beg.time),
+                                        TangentVector::Ones());
+  return LocalState(beg, end) - transition * LocalState(beg, beg);
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::StateMatrix GPTrajectory<Group>::PriorInformation(
+    size_t k) const {
+  assert(k + 1 < states_.size());
+  const Scalar dt = states_[k + 1].time - states_[k].time;
+  // (Q(dt) kron Qc)^{-1} = Q(dt)^{-1} kron Qc^{-1}.
+  return Expand(ProcessCovariance(dt).inverse(),
+                power_spectral_density_.cwiseInverse());
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::Scalar GPTrajectory<Group>::PriorCost() const {
+  Scalar cost = 0;
+  for (size_t k = 0; k + 1 < states_.size(); ++k) {
+    const StateVector error = PriorError(k);
+    cost += error.dot(PriorInformation(k) * error) / 2;
+  }
+  return cost;
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::InformationMatrix
+GPTrajectory<Group>::PriorInformationMatrix() const {
+  InformationMatrix information(states_.size());
+  for (size_t k = 0; k + 1 < states_.size(); ++k) {
+    const StateMatrix transition =
+        Expand(Transition(states_[k + 1].time - states_[k].time),
+               TangentVector::Ones());
+    const StateMatrix prior_information = PriorInformation(k);
+    information.diagonal[k].noalias() +=
+        transition.transpose() * prior_information * transition;
+    information.diagonal[k + 1] += prior_information;
+    information.upper[k].noalias() -=
+        transition.transpose() * prior_information;
+  }
+  return information;
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::Scalar GPTrajectory<Group>::BeginTime() const {
+  assert(!states_.empty());
+  return states_.front().time;
+}
+
+template <typename Group>
+typename GPTrajectory<Group>::Scalar GPTrajectory<Group>::EndTime() const {
+  assert(!states_.empty());
+  return states_.back().time;
+}
+
+template <typename Group>
+size_t GPTrajectory<Group>::NumStates() const {
+  return states_.size();
+}
+
+template <typename Group>
+const std::vector<typename GPTrajectory<Group>::State>&
+GPTrajectory<Group>::states() const {
+  return states_;
+}
+
+template <typename Group>
+std::vector<typename GPTrajectory<Group>::State>&
+GPTrajectory<Group>::states() {
+  return states_;
+}
+
+template <typename Group>
+const typename GPTrajectory<Group>::TangentVector&
+GPTrajectory<Group>::PowerSpectralDensity() const {
+  return power_spectral_density_;
+}
+
+template <typename Group>
+/*static*/ Eigen::Matrix<typename GPTrajectory<Group>::Scalar, 3, 3>
+GPTrajectory<Group>::Transition(Scalar dt) {
+  Eigen::Matrix<Scalar, 3, 3> transition;
+  transition << 1, dt, dt * dt / 2,  //
+      0, 1, dt,                      //
+      0, 0, 1;
+  return transition;
+}
+
+template <typename Group>
+/*static*/ Eigen::Matrix<typename GPTrajectory<Group>::Scalar, 3, 3>
+GPTrajectory<Group>::ProcessCovariance(Scalar dt) {
+  const Scalar dt2 = dt * dt;
+  const Scalar dt3 = dt2 * dt;
+  const Scalar dt4 = dt3 * dt;
+  const Scalar dt5 = dt4 * dt;
+  Eigen::Matrix<Scalar, 3, 3> covariance;
+  covariance << dt5 / 20, dt4 / 8, dt3 / 6,  //
+      dt4 / 8, dt3 / 3, dt2 / 2,             //
+      dt3 / 6, dt2 / 2, dt;
+  return covariance;
+}
+
+template <typename Group>
+/*static*/ typename GPTrajectory<Group>::StateMatrix
+GPTrajectory<Group>::Expand(const Eigen::Matrix<Scalar, 3, 3>& matrix,
+                            const TangentVector& scale) {
+  StateMatrix expanded = StateMatrix::Zero();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      expanded.template block<Dimension, Dimension>(i * Dimension,
+                                                    j * Dimension) =
+          (matrix(i, j) * scale).asDiagonal();
+    }
+  }
+  return expanded;
+}
+
+template <typename Group>
+/*static*/ typename GPTrajectory<Group>::StateVector
+GPTrajectory<Group>::LocalState(const State& origin, const State& state) {
+  StateVector local;
+  local << origin.value.Rminus(state.value), state.velocity,
+      state.acceleration;
+  return local;
+}
+
+}  // namespace mana
@@ -0,0 +1,99 @@
+#include "spline/gp_trajectory.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+// A quintic angle trajectory and its derivatives.
+struct Quintic {
+  double Angle(double t) const {
+    return 0.5 * t + 0.2 * t * t - 0.03 * t * t * t + 1e-3 * std::pow(t, 5);
+  }
+  double Rate(double t) const {
+    return 0.5 + 0.4 * t - 0.09 * t * t + 5e-3 * std::pow(t, 4);
+  }
+  double Accel(double t) const { return 0.4 - 0.18 * t + 2e-2 * t * t * t; }
+};
+
+GPTrajectory<SO2GroupElement> MakeTrajectory(const Quintic& curve) {
+  GPTrajectory<SO2GroupElement> trajectory(Vector1d(1.0));
+  for (double t = 0; t <= 5.0; t += 0.5) {
+    trajectory.AddState(t, SO2GroupElement(curve.Angle(t)),
+                        Vector1d(curve.Rate(t)), Vector1d(curve.Accel(t)));
+  }
+  return trajectory;
+}
+
+TEST(GPTrajectory, InterpolatesStates) {
+  const GPTrajectory<SO2GroupElement> trajectory = MakeTrajectory(Quintic());
+  for (const auto& state : trajectory.states()) {
+    EXPECT_EQ(trajectory.At(state.time), state.value);
+  }
+}
+
+TEST(GPTrajectory, ReproducesQuinticMotion) {
+  // The WNOJ posterior mean between two states is the quintic polynomial
+  // matching both states, so quintic motion on SO2 is reproduced exactly.
+  const Quintic curve;
+  const GPTrajectory<SO2GroupElement> trajectory = MakeTrajectory(curve);
+  for (double t = 0; t <= 5.0; t += 0.01) {
+    EXPECT_LT(trajectory.At(t).DistanceTo(SO2GroupElement(curve.Angle(t))),
+              1e-9);
+  }
+}
+
+TEST(GPTrajectory, PriorErrorVanishesForConstantAcceleration) {
+  GPTrajectory<SO2GroupElement> trajectory(Vector1d(1.0));
+  for (double t = 0; t <= 2.0; t += 0.25) {
+    trajectory.AddState(t, SO2GroupElement(0.3 * t + 0.1 * t * t),
+                        Vector1d(0.3 + 0.2 * t), Vector1d(0.2));
+  }
+  for (size_t k = 0; k + 1 < trajectory.NumStates(); ++k) {
+    EXPECT_LT(trajectory.PriorError(k).cwiseAbs().maxCoeff(), 1e-12);
+  }
+  EXPECT_LT(trajectory.PriorCost(), 1e-20);
+}
+
+TEST(GPTrajectory, PriorInformationMatrixIsBlockTridiagonal) {
+  using Trajectory = GPTrajectory<SO2GroupElement>;
+  constexpr int kDim = Trajectory::StateDimension;
+  const Trajectory trajectory = MakeTrajectory(Quintic());
+  const size_t n = trajectory.NumStates();
+
+  // Assemble the prior information densely from its factors.
+  Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(n * kDim, n * kDim);
+  for (size_t k = 0; k + 1 < n; ++k) {
+    const double dt =
+        trajectory.states()[k + 1].time - trajectory.states()[k].time;
+    Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(kDim, n * kDim);
+    jacobian.block<kDim, kDim>(0, k * kDim) = -Trajectory::Transition(dt);
+    jacobian.block<kDim, kDim>(0, (k + 1) * kDim).setIdentity();
+    dense += jacobian.transpose() * trajectory.PriorInformation(k) * jacobian;
+  }
+
+  const Trajectory::InformationMatrix information =
+      trajectory.PriorInformationMatrix();
+  ASSERT_EQ(information.size(), n);
+  for (size_t k = 0; k < n; ++k) {
+    EXPECT_LT((information.diagonal[k] -
+               dense.block<kDim, kDim>(k * kDim, k * kDim))
+                  .cwiseAbs()
+                  .maxCoeff(),
+              1e-6);
+    if (k + 1 < n) {
+      EXPECT_LT((information.upper[k] -
+                 dense.block<kDim, kDim>(k * kDim, (k + 1) * kDim))
+                    .cwiseAbs()
+                    .maxCoeff(),
+                1e-6);
+    }
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <Eigen/Dense>
+
+#include "spline/spline.h"
+#include "spline/trajectory_file.h"
+#include "utils/mapped_file.h"
+
+namespace mana {
+
+// A read-only cubic Hermite spline backed by a memory-mapped trajectory file
+// (see trajectory_file.h). Queries read knots directly from the mapping: only
+// the two knots bracketing the query time are touched, and nothing is parsed or
+// copied up front, so opening a multi-hour trajectory costs one `mmap`.
+template <typename Group>
+class MmapSpline {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Knot = SplineKnot<Group>;
+
+  // Map the trajectory file at `path`. Returns std::nullopt if the file cannot
+  // be mapped, or if it does not hold a valid trajectory of `Group` knots.
+  static std::optional<MmapSpline> Open(const std::string& path);
+
+  // Evaluate the spline at the provided time, which must lie within
+  // [BeginTime(), EndTime()].
+  Group At(Scalar time) const;
+
+  // Return the time range spanned by the spline's knots.
+  Scalar BeginTime() const;
+  Scalar EndTime() const;
+
+  // Return the number of knots in the spline.
+  size_t NumKnots() const;
+
+  // Return the knot at `index`, read from the mapping.
+  Knot knot(size_t index) const;
+
+ private:
+  MmapSpline(MappedFile file, const TrajectoryFileHeader& header);
+
+  MappedFile file_;
+  size_t num_knots_;
+  // Sections of the mapped file (see trajectory_file.h for the layout).
+  const Scalar* timestamps_;
+  const Scalar* values_;
+  const Scalar* velocities_;
+};
+
+template <typename Group>
+/*static*/ std::optional<MmapSpline<Group>> MmapSpline<Group>::Open(
+    const std::string& path) {
+  std::optional<MappedFile> file = MappedFile::Open(path);
+  if (!file || file->size() < sizeof(TrajectoryFileHeader)) return std::nullopt;
+  // The mapping is page-aligned, so the header can be read in place.
+  const auto& header =
+      *static_cast<const TrajectoryFileHeader*>(file->data());
+  if (!IsValidTrajectoryFileHeader<Group>(header, file->size()) ||
+      header.num_knots == 0) {
+    return std::nullopt;
+  }
+  return MmapSpline(std::move(*file), header);
+}
+
+template <typename Group>
+Group MmapSpline<Group>::At(Scalar time) const {
+  assert(time >= BeginTime() && time <= EndTime());
+  if (num_knots_ == 1) return knot(0).value;
+  // Find the last knot with knot.time <= time, excluding the final knot.
+  const Scalar* it =
+      std::upper_bound(timestamps_ + 1, timestamps_ + num_knots_ - 1, time);
+  const size_t index = (it - timestamps_) - 1;
+  return InterpolateHermite(knot(index), knot(index + 1), time);
+}
+
+template <typename Group>
+typename MmapSpline<Group>::Scalar MmapSpline<Group>::BeginTime() const {
+  return timestamps_[0];
+}
+
+template <typename Group>
+typename MmapSpline<Group>::Scalar MmapSpline<Group>::EndTime() const {
+  return timestamps_[num_knots_ - 1];
+}
+
+template <typename Group>
+size_t MmapSpline<Group>::NumKnots() const {
+  return num_knots_;
+}
+
+template <typename Group>
+typename MmapSpline<Group>::Knot MmapSpline<Group>::knot(size_t index) const {
+  assert(index < num_knots_);
+  return Knot{
+      timestamps_[index],
+      Group::FromStorage(values_ + index * Group::StorageDimension),
+      Eigen::Map<const TangentVector>(velocities_ + index * Group::Dimension)};
+}
+
+template <typename Group>
+MmapSpline<Group>::MmapSpline(MappedFile file,
+                              const TrajectoryFileHeader& header)
+    : file_(std::move(file)), num_knots_(header.num_knots) {
+  const char* base = static_cast<const char*>(file_.data());
+  timestamps_ =
+      reinterpret_cast<const Scalar*>(base + header.timestamps_offset);
+  values_ = reinterpret_cast<const Scalar*>(base + header.values_offset);
+  velocities_ =
+      reinterpret_cast<const Scalar*>(base + header.velocities_offset);
+}
+
+}  // namespace mana
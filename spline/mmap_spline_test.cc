@@ -0,0 +1,72 @@
+#include "spline/mmap_spline.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+#include "spline/spline.h"
+#include "spline/trajectory_file.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+TEST(MmapSpline, RoundTrip) {
+  CubicHermiteSpline<SO2GroupElement> spline;
+  for (int i = 0; i < 100; ++i) {
+    spline.AddKnot(0.1 * i, SO2GroupElement(std::sin(0.3 * i)),
+                   Vector1d(0.3 * std::cos(0.3 * i)));
+  }
+  const std::string path = testing::TempDir() + "/round_trip.traj";
+  ASSERT_TRUE(WriteTrajectoryFile(path, spline));
+
+  std::optional<MmapSpline<SO2GroupElement>> mapped =
+      MmapSpline<SO2GroupElement>::Open(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(mapped->NumKnots(), spline.NumKnots());
+  EXPECT_EQ(mapped->BeginTime(), spline.BeginTime());
+  EXPECT_EQ(mapped->EndTime(), spline.EndTime());
+  for (size_t i = 0; i < spline.NumKnots(); ++i) {
+    EXPECT_EQ(mapped->knot(i).time, spline.knots()[i].time);
+    EXPECT_EQ(mapped->knot(i).value, spline.knots()[i].value);
+    EXPECT_EQ(mapped->knot(i).velocity, spline.knots()[i].velocity);
+  }
+  for (double t = spline.BeginTime(); t <= spline.EndTime(); t += 0.013) {
+    EXPECT_EQ(mapped->At(t), spline.At(t));
+  }
+}
+
+TEST(MmapSpline, SectionsAreAligned) {
+  const TrajectoryFileHeader header =
+      MakeTrajectoryFileHeader<SO2GroupElement>(/*num_knots=*/3);
+  EXPECT_EQ(header.timestamps_offset % kTrajectoryFileAlignment, 0);
+  EXPECT_EQ(header.values_offset % kTrajectoryFileAlignment, 0);
+  EXPECT_EQ(header.velocities_offset % kTrajectoryFileAlignment, 0);
+  EXPECT_EQ(header.storage_dimension, 2);
+  EXPECT_EQ(header.tangent_dimension, 1);
+}
+
+TEST(MmapSpline, RejectsInvalidFiles) {
+  EXPECT_FALSE(MmapSpline<SO2GroupElement>::Open(testing::TempDir() +
+                                                 "/does_not_exist.traj"));
+
+  const std::string path = testing::TempDir() + "/garbage.traj";
+  std::ofstream(path) << std::string(256, 'x');
+  EXPECT_FALSE(MmapSpline<SO2GroupElement>::Open(path));
+
+  // A knot count whose section sizes wrap around to zero must not pass for a
+  // file holding only the header.
+  const TrajectoryFileHeader header =
+      MakeTrajectoryFileHeader<SO2GroupElement>(uint64_t{1} << 61);
+  const std::string truncated = testing::TempDir() + "/truncated.traj";
+  std::ofstream(truncated, std::ios::binary)
+      .write(reinterpret_cast<const char*>(&header), sizeof(header));
+  EXPECT_FALSE(IsValidTrajectoryFileHeader<SO2GroupElement>(header,
+                                                            header.file_size));
+  EXPECT_FALSE(MmapSpline<SO2GroupElement>::Open(truncated));
+}
+
+}  // namespace mana
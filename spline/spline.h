@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "lie/base/constants.h"
+
+namespace mana {
+
+// A knot of a cubic Hermite spline on a Lie group. The velocity is expressed
+// in the tangent space of `value` (i.e. it is the right-trivialized, or
+// body-frame, time derivative of the curve at `time`).
+template <typename Group>
+struct SplineKnot {
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+
+  Scalar time;
+  Group value;
+  TangentVector velocity;
+};
+
+// The cubic Hermite basis functions, evaluated at normalized segment time `s`
+// (0 at the start of the segment, 1 at its end).
+template <typename Scalar>
+struct HermiteBasis {
+  explicit HermiteBasis(Scalar s);
+
+  // Weights of the start point, start tangent, end point, and end tangent.
+  Scalar h00, h10, h01, h11;
+};
+
+// Find the segment of a sorted knot sequence that contains `time`, returning
+// the index of the segment's first knot. `Knots` may be any random-access
+// sequence of `SplineKnot<>` exposing `size()` and `operator[]`. Assumes there
+// are at least two knots, and that `time` lies within the knots' time range.
+template <typename Knots, typename Scalar>
+size_t FindSegment(const Knots& knots, Scalar time);
+
+// Evaluate the cubic Hermite segment between knots `beg` and `end` at `time`.
+// The segment is built in the tangent space of `beg.value`:
+//   X(s) = X0 * Exp(h10(s)*dt*v0 + h01(s)*d + h11(s)*dt*Jr^{-1}(d)*v1),
+// where d = Log(X0^{-1} X1), s = (time - t0) / dt is the normalized segment
+// time, and h10, h01, h11 are the standard cubic Hermite basis functions. The
+// body velocity of X0 * Exp(tau(t)) is Jr(tau) tau', so mapping v1 through
+// Jr^{-1}(d) makes the segment end with velocity v1, and consecutive segments
+// join with continuous velocity. Segment endpoints are interpolated exactly.
+template <typename Group>
+Group InterpolateHermite(const SplineKnot<Group>& beg,
+                         const SplineKnot<Group>& end,
+                         typename Group::Scalar time);
+
+// A cubic Hermite spline over elements of a Lie group, defined by a sequence of
+// knots with strictly increasing timestamps.
+//
+// For abelian groups (see `IsAbelianLieGroup<>`), e.g. SO2 or R^n, Exp and Log
+// are homomorphisms, so the spline is an ordinary vector-valued Hermite spline
+// in exponential coordinates. The knots' (unwrapped) coordinates are cached as
+// knots are added, and evaluating the spline is a scalar polynomial followed by
+// a single Exp, with no Log or composition.
+template <typename Group>
+class CubicHermiteSpline {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Knot = SplineKnot<Group>;
+
+  // Construct an empty spline.
+  CubicHermiteSpline() = default;
+
+  // Construct from knots with strictly increasing times.
+  explicit CubicHermiteSpline(std::vector<Knot> knots);
+
+  // Append a knot to the end of the spline. Knot times must be strictly
+  // increasing.
+  void AddKnot(Scalar time, Group value, TangentVector velocity);
+
+  // Evaluate the spline at the provided time, which must lie within
+  // [BeginTime(), EndTime()].
+  Group At(Scalar time) const;
+
+  // Evaluate the spline at `n` uniformly spaced times beg_time,
+  // beg_time + step, ..., which must all lie within [BeginTime(), EndTime()].
+  // Segments are walked incrementally rather than searched for, and per-segment
+  // work (Log(X_k^{-1} X_{k+1})) is done once per segment. For abelian groups
+  // the spline's exponential coordinates are a cubic in the sample index, so
+  // samples are generated by forward differencing in the group itself:
+  // three compositions per sample, with no Exp or Log except when re-anchoring
+  // every `kRecurrenceResyncPeriod` samples.
+  std::vector<Group> SampleUniform(Scalar beg_time, Scalar step,
+                                   size_t n) const;
+
+  // Return the time range spanned by the spline's knots.
+  Scalar BeginTime() const;
+  Scalar EndTime() const;
+
+  // Return the number of knots in the spline.
+  size_t NumKnots() const;
+
+  // Access the underlying knots.
+  const std::vector<Knot>& knots() const;
+
+ private:
+  // Abelian groups only: the spline's exponential coordinates at `time`, which
+  // must lie in the segment starting at knot `index`.
+  TangentVector CoordinatesAt(size_t index, Scalar time) const;
+
+  // Append the exponential coordinates of the newest knot to `coordinates_`.
+  // Only used for abelian groups.
+  void AppendCoordinates();
+
+  std::vector<Knot> knots_;
+  // Abelian groups only: exponential coordinates of each knot's value,
+  // unwrapped so that consecutive coordinates differ by
+  // Log(X_k^{-1} X_{k+1}).
+  std::vector<TangentVector> coordinates_;
+};
+
+template <typename Scalar>
+HermiteBasis<Scalar>::HermiteBasis(Scalar s) {
+  const Scalar s2 = s * s;
+  const Scalar s3 = s2 * s;
+  h00 = 2 * s3 - 3 * s2 + 1;
+  h10 = s3 - 2 * s2 + s;
+  h01 = -2 * s3 + 3 * s2;
+  h11 = s3 - s2;
+}
+
+template <typename Knots, typename Scalar>
+size_t FindSegment(const Knots& knots, Scalar time) {
+  assert(knots.size() >= 2);
+  // Binary search for the last knot with knot.time <= time, leaving the final
+  // knot out so that `time == knots.back().time` maps to the last segment.
+  size_t lo = 0;
+  size_t hi = knots.size() - 1;
+  while (hi - lo > 1) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (knots[mid].time <= time) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+template <typename Group>
+Group InterpolateHermite(const SplineKnot<Group>& beg,
+                         const SplineKnot<Group>& end,
+                         typename Group::Scalar time) {
+  using Scalar = typename Group::Scalar;
+  const Scalar dt = end.time - beg.time;
+  assert(dt > 0);
+  // h00 multiplies the zero vector, the tangent-space coordinate of
+  // `beg.value` itself.
+  const HermiteBasis<Scalar> basis((time - beg.time) / dt);
+  const typename Group::TangentVector delta = beg.value.Rminus(end.value);
+  const typename Group::TangentVector tau =
+      (basis.h10 * dt) * beg.velocity + basis.h01 * delta +
+      (basis.h11 * dt) * (Group::RightJacobianInverse(delta) * end.velocity);
+  return beg.value.Rplus(tau);
+}
+
+template <typename Group>
+CubicHermiteSpline<Group>::CubicHermiteSpline(std::vector<Knot> knots) {
+  knots_.reserve(knots.size());
+  for (Knot& knot : knots) {
+    AddKnot(knot.time, std::move(knot.value), std::move(knot.velocity));
+  }
+}
+
+template <typename Group>
+void CubicHermiteSpline<Group>::AddKnot(Scalar time, Group value,
+                                        TangentVector velocity) {
+  assert(knots_.empty() || time > knots_.back().time);
+  knots_.push_back(Knot{time, std::move(value), std::move(velocity)});
+  if constexpr (Group::IsAbelian) AppendCoordinates();
+}
+
+template <typename Group>
+Group CubicHermiteSpline<Group>::At(Scalar time) const {
+  assert(!knots_.empty());
+  assert(time >= BeginTime() && time <= EndTime());
+  if (knots_.size() == 1) return knots_.front().value;
+  const size_t index = FindSegment(knots_, time);
+  if constexpr (Group::IsAbelian) {
+    return Group::Exp(CoordinatesAt(index, time));
+  } else {
+    return InterpolateHermite(knots_[index], knots_[index + 1], time);
+  }
+}
+
+template <typename Group>
+std::vector<Group> CubicHermiteSpline<Group>::SampleUniform(Scalar beg_time,
+                                                            Scalar step,
+                                                            size_t n) const {
+  std::vector<Group> samples;
+  samples.reserve(n);
+  if (n == 0) return samples;
+  assert(beg_time >= BeginTime() && beg_time + (n - 1) * step <= EndTime());
+  if (knots_.size() == 1) {
+    samples.assign(n, knots_.front().value);
+    return samples;
+  }
+
+  size_t index = FindSegment(knots_, beg_time);
+  size_t i = 0;
+  while (i < n) {
+    // Advance to the segment containing sample i, and count the samples in it.
+    const auto time_of = [&](size_t j) { return beg_time + j * step; };
+    while (index + 2 < knots_.size() && knots_[index + 1].time <= time_of(i)) {
+      ++index;
+    }
+    size_t end_i = i + 1;
+    const bool is_last_segment = (index + 2 == knots_.size());
+    while (end_i < n &&
+           (is_last_segment || time_of(end_i) < knots_[index + 1].time)) {
+      ++end_i;
+    }
+
+    if constexpr (Group::IsAbelian) {
+      // c(j) is a cubic in the sample index j, so its third forward difference
+      // is constant. Since Exp is a homomorphism, X_j = Exp(c(j)) satisfies
+      //   X_{j+1} = X_j * D1_j,  D1_{j+1} = D1_j * D2_j,  D2_{j+1} = D2_j * D3,
+      // where D1, D2, D3 are the Exps of the first three forward differences.
+      // The differences are computed from the segment's polynomial
+      // coefficients rather than by subtracting nearby coordinates, which
+      // would lose precision to cancellation.
+      const Knot& beg = knots_[index];
+      const Knot& end = knots_[index + 1];
+      const Scalar dt = end.time - beg.time;
+      // c(s) = c_k + p1 s + p2 s^2 + p3 s^3, for normalized segment time s.
+      const TangentVector delta = coordinates_[index + 1] - coordinates_[index];
+      const TangentVector p1 = dt * beg.velocity;
+      const TangentVector p2 = 3 * delta - 2 * p1 - dt * end.velocity;
+      const TangentVector p3 = -2 * delta + p1 + dt * end.velocity;
+      const Scalar ds = step / dt;
+      for (size_t anchor = i; anchor < end_i;
+           anchor += kRecurrenceResyncPeriod) {
+        // Expand c about the anchor: c(j) = c0 + a1 j + a2 j^2 + a3 j^3.
+        const Scalar s = (time_of(anchor) - beg.time) / dt;
+        const TangentVector a1 = ds * (p1 + 2 * s * p2 + 3 * s * s * p3);
+        const TangentVector a2 = (ds * ds) * (p2 + 3 * s * p3);
+        const TangentVector a3 = (ds * ds * ds) * p3;
+        Group value = Group::Exp(CoordinatesAt(index, time_of(anchor)));
+        Group d1 = Group::Exp(a1 + a2 + a3);
+        Group d2 = Group::Exp(2 * a2 + 6 * a3);
+        const Group d3 = Group::Exp(6 * a3);
+        const size_t anchor_end =
+            std::min(end_i, anchor + kRecurrenceResyncPeriod);
+        for (size_t j = anchor; j < anchor_end; ++j) {
+          samples.push_back(value);
+          value = value.Compose(d1);
+          d1 = d1.Compose(d2);
+          d2 = d2.Compose(d3);
+        }
+      }
+    } else {
+      const Knot& beg = knots_[index];
+      const Knot& end = knots_[index + 1];
+      const Scalar dt = end.time - beg.time;
+      const TangentVector delta = beg.value.Rminus(end.value);
+      const TangentVector end_velocity =
+          Group::RightJacobianInverse(delta) * end.velocity;
+      for (size_t j = i; j < end_i; ++j) {
+        const HermiteBasis<Scalar> basis((time_of(j) - beg.time) / dt);
+        samples.push_back(beg.value.Rplus((basis.h10 * dt) * beg.velocity +
+                                          basis.h01 * delta +
+                                          (basis.h11 * dt) * end_velocity));
+      }
+    }
+    i = end_i;
+  }
+  return samples;
+}
+
+template <typename Group>
+typename CubicHermiteSpline<Group>::Scalar
+CubicHermiteSpline<Group>::BeginTime() const {
+  assert(!knots_.empty());
+  return knots_.front().time;
+}
+
+template <typename Group>
+typename CubicHermiteSpline<Group>::Scalar
+CubicHermiteSpline<Group>::EndTime() const {
+  assert(!knots_.empty());
+  return knots_.back().time;
+}
+
+template <typename Group>
+size_t CubicHermiteSpline<Group>::NumKnots() const {
+  return knots_.size();
+}
+
+template <typename Group>
+const std::vector<typename CubicHermiteSpline<Group>::Knot>&
+CubicHermiteSpline<Group>::knots() const {
+  return knots_;
+}
+
+template <typename Group>
+typename CubicHermiteSpline<Group>::TangentVector
+CubicHermiteSpline<Group>::CoordinatesAt(size_t index, Scalar time) const {
+  const Knot& beg = knots_[index];
+  const Knot& end = knots_[index + 1];
+  const Scalar dt = end.time - beg.time;
+  const HermiteBasis<Scalar> basis((time - beg.time) / dt);
+  return basis.h00 * coordinates_[index] + (basis.h10 * dt) * beg.velocity +
+         basis.h01 * coordinates_[index + 1] + (basis.h11 * dt) * end.velocity;
+}
+
+template <typename Group>
+void CubicHermiteSpline<Group>::AppendCoordinates() {
+  const size_t n = knots_.size();
+  if (n == 1) {
+    coordinates_.push_back(knots_[0].value.Log());
+  } else {
+    coordinates_.push_back(coordinates_[n - 2] +
+                           knots_[n - 2].value.Rminus(knots_[n - 1].value));
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "spline/spline.h"
+#include "utils/block_tridiagonal.h"
+
+namespace mana {
+
+// A timestamped sample of a trajectory, e.g. a pose from an external tracking
+// system.
+template <typename Group>
+struct SplineSample {
+  typename Group::Scalar time;
+  Group value;
+};
+
+// Options for `FitSpline()`.
+struct SplineFitOptions {
+  // Spacing between knots, in seconds, when knot times are not provided.
+  double knot_spacing = 0.1;
+  // Maximum number of Gauss-Newton iterations.
+  int max_iterations = 10;
+  // Stop iterating once the largest update falls below this magnitude.
+  double convergence_tolerance = 1e-10;
+  // Damping added to the normal equations' diagonal. Keeps knots whose
+  // segments have too few samples to constrain their velocity well-posed.
+  double damping = 1e-9;
+  // Step size for the numerical Jacobians of samples w.r.t. knots.
+  double jacobian_step = 1e-6;
+};
+
+// The factorization of a spline fit's normal equations, in blocks of one
+// knot's [value; velocity] perturbation (see block_tridiagonal.h).
+template <typename Group>
+using SplineFitFactorization =
+    BlockTridiagonalFactorization<typename Group::Scalar, 2 * Group::Dimension>;
+
+// Fit a cubic Hermite spline with knots at `knot_times` (strictly increasing,
+// at least two) to `samples` (sorted by time, within the knot time range), in
+// the least squares sense:
+//   argmin sum_i || Log(X(t_i)^{-1} Z_i) ||^2.
+// Each sample only depends on the two knots bracketing it, so the normal
+// equations are block tridiagonal in the knots, and each Gauss-Newton
+// iteration is solved with a block Thomas solver in time linear in the number
+// of knots and samples. For abelian groups the problem is linear and the
+// Jacobians are the (analytic) Hermite basis weights; other groups use
+// numerical Jacobians. Returns std::nullopt if the normal equations are
+// singular.
+//
+// If `factorization` is not null, it is set to the factorization of the normal
+// equations of the last iteration (linearized at the knots before its
+// update, which is below the tolerance once converged). Their inverse is the
+// covariance of the knots' perturbations per unit residual variance, so
+// `MarginalCovariances()` or `SparseInverse()` recover knot uncertainties from
+// it without refactoring.
+template <typename Group>
+std::optional<CubicHermiteSpline<Group>> FitSpline(
+    const std::vector<SplineSample<Group>>& samples,
+    const std::vector<typename Group::Scalar>& knot_times,
+    const SplineFitOptions& options = {},
+    SplineFitFactorization<Group>* factorization = nullptr);
+
+// As above, with knots spaced uniformly by `options.knot_spacing` over the time
+// range of the samples.
+template <typename Group>
+std::optional<CubicHermiteSpline<Group>> FitSpline(
+    const std::vector<SplineSample<Group>>& samples,
+    const SplineFitOptions& options = {},
+    SplineFitFactorization<Group>* factorization = nullptr);
+
+namespace internal {
+
+// Initial guess for a spline fit: knot values are taken from the nearest
+// sample, knot velocities from finite differences of neighbouring knot values.
+template <typename Group>
+std::vector<SplineKnot<Group>> InitialSplineGuess(
+    const std::vector<SplineSample<Group>>& samples,
+    const std::vector<typename Group::Scalar>& knot_times) {
+  using Scalar = typename Group::Scalar;
+  std::vector<SplineKnot<Group>> knots;
+  knots.reserve(knot_times.size());
+  for (const Scalar time : knot_times) {
+    const auto it = std::lower_bound(
+        samples.begin(), samples.end(), time,
+        [](const SplineSample<Group>& sample, Scalar t) {
+          return sample.time < t;
+        });
+    const SplineSample<Group>& nearest =
+        (it == samples.end() ||
+         (it != samples.begin() && time - (it - 1)->time < it->time - time))
+            ? *(it - 1)
+            : *it;
+    knots.push_back({time, nearest.value, Group::TangentVector::Zero()});
+  }
+  for (size_t k = 0; k < knots.size(); ++k) {
+    const size_t prev = (k == 0) ? k : k - 1;
+    const size_t next = (k + 1 == knots.size()) ? k : k + 1;
+    knots[k].velocity = knots[prev].value.Rminus(knots[next].value) /
+                        (knots[next].time - knots[prev].time);
+  }
+  return knots;
+}
+
+}  // namespace internal
+
+template <typename Group>
+std::optional<CubicHermiteSpline<Group>> FitSpline(
+    const std::vector<SplineSample<Group>>& samples,
+    const std::vector<typename Group::Scalar>& knot_times,
+    const SplineFitOptions& options,
+    SplineFitFactorization<Group>* factorization) {
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Knot = SplineKnot<Group>;
+  constexpr int kDim = Group::Dimension;
+  // Each knot contributes a value perturbation and a velocity perturbation.
+  constexpr int kBlockDim = 2 * kDim;
+  using Normal = BlockTridiagonalMatrix<Scalar, kBlockDim>;
+  using BlockVector = typename Normal::Vector;
+  using SampleJacobian = Eigen::Matrix<Scalar, kDim, 2 * kBlockDim>;
+
+  assert(knot_times.size() >= 2);
+  assert(!samples.empty());
+  assert(samples.front().time >= knot_times.front());
+  assert(samples.back().time <= knot_times.back());
+
+  std::vector<Knot> knots = internal::InitialSplineGuess(samples, knot_times);
+  const size_t num_knots = knots.size();
+
+  // Apply perturbation `delta` (stacked [value; velocity]) to a knot.
+  const auto perturbed = [](const Knot& knot, const BlockVector& delta) {
+    return Knot{knot.time,
+                knot.value.Rplus(TangentVector(delta.template head<kDim>())),
+                knot.velocity + delta.template tail<kDim>()};
+  };
+
+  Normal normal(num_knots);
+  std::vector<BlockVector> rhs(num_knots);
+  std::vector<BlockVector> update;
+  SplineFitFactorization<Group> local_factorization;
+  SplineFitFactorization<Group>& factors =
+      factorization != nullptr ? *factorization : local_factorization;
+  for (int iteration = 0; iteration < options.max_iterations; ++iteration) {
+    for (size_t k = 0; k < num_knots; ++k) {
+      normal.diagonal[k] =
+          Normal::Block::Identity() * static_cast<Scalar>(options.damping);
+      if (k + 1 < num_knots) normal.upper[k].setZero();
+      rhs[k].setZero();
+    }
+
+    // Samples are sorted, so the bracketing segment only moves forward.
+    size_t segment = 0;
+    for (const SplineSample<Group>& sample : samples) {
+      while (segment + 2 < num_knots &&
+             knots[segment + 1].time <= sample.time) {
+        ++segment;
+      }
+      const Knot& beg = knots[segment];
+      const Knot& end = knots[segment + 1];
+      const TangentVector residual =
+          InterpolateHermite(beg, end, sample.time).Rminus(sample.value);
+
+      SampleJacobian jacobian;
+      if constexpr (Group::IsAbelian) {
+        // The spline is X(t) = Exp(h00 c0 + h10 dt v0 + h01 c1 + h11 dt v1) in
+        // exponential coordinates c, and the residual is Log(Z) - c(t).
+        using Identity = Eigen::Matrix<Scalar, kDim, kDim>;
+        const Scalar dt = end.time - beg.time;
+        const HermiteBasis<Scalar> basis((sample.time - beg.time) / dt);
+        jacobian << -basis.h00 * Identity::Identity(),
+            -basis.h10 * dt * Identity::Identity(),
+            -basis.h01 * Identity::Identity(),
+            -basis.h11 * dt * Identity::Identity();
+      } else {
+        // Central-difference Jacobian of the residual w.r.t. both knots.
+        for (int j = 0; j < 2 * kBlockDim; ++j) {
+          BlockVector delta = BlockVector::Zero();
+          delta(j % kBlockDim) = options.jacobian_step;
+          const bool is_beg = j < kBlockDim;
+          const Knot beg_plus = is_beg ? perturbed(beg, delta) : beg;
+          const Knot end_plus = is_beg ? end : perturbed(end, delta);
+          const Knot beg_minus = is_beg ? perturbed(beg, -delta) : beg;
+          const Knot end_minus = is_beg ? end : perturbed(end, -delta);
+          jacobian.col(j) =
+              (InterpolateHermite(beg_plus, end_plus, sample.time)
+                   .Rminus(sample.value) -
+               InterpolateHermite(beg_minus, end_minus, sample.time)
+                   .Rminus(sample.value)) /
+              (2 * options.jacobian_step);
+        }
+      }
+
+      const auto j_beg = jacobian.template leftCols<kBlockDim>();
+      const auto j_end = jacobian.template rightCols<kBlockDim>();
+      normal.diagonal[segment].noalias() += j_beg.transpose() * j_beg;
+      normal.diagonal[segment + 1].noalias() += j_end.transpose() * j_end;
+      normal.upper[segment].noalias() += j_beg.transpose() * j_end;
+      rhs[segment].noalias() -= j_beg.transpose() * residual;
+      rhs[segment + 1].noalias() -= j_end.transpose() * residual;
+    }
+
+    if (!FactorBlockTridiagonal(normal, factors)) return std::nullopt;
+    SolveBlockTridiagonal(normal, factors, rhs, update);
+
+    Scalar max_update = 0;
+    for (size_t k = 0; k < num_knots; ++k) {
+      knots[k] = perturbed(knots[k], update[k]);
+      max_update = std::max(max_update, update[k].cwiseAbs().maxCoeff());
+    }
+    if (max_update < options.convergence_tolerance) break;
+  }
+  return CubicHermiteSpline<Group>(std::move(knots));
+}
+
+template <typename Group>
+std::optional<CubicHermiteSpline<Group>> FitSpline(
+    const std::vector<SplineSample<Group>>& samples,
+    const SplineFitOptions& options,
+    SplineFitFactorization<Group>* factorization) {
+  using Scalar = typename Group::Scalar;
+  assert(!samples.empty());
+  assert(options.knot_spacing > 0);
+  const Scalar begin = samples.front().time;
+  const Scalar end = samples.back().time;
+  const size_t num_segments = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil((end - begin) / options.knot_spacing)));
+  std::vector<Scalar> knot_times(num_segments + 1);
+  for (size_t k = 0; k <= num_segments; ++k) {
+    knot_times[k] = begin + (end - begin) * k / num_segments;
+  }
+  return FitSpline(samples, knot_times, options, factorization);
+}
+
+}  // namespace mana
@@ -0,0 +1,101 @@
+#include "spline/spline_fitting.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+#include "spline/spline.h"
+#include "utils/block_tridiagonal.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+TEST(FitSpline, RecoversSplineFromItsSamples) {
+  CubicHermiteSpline<SO2GroupElement> truth;
+  std::vector<double> knot_times;
+  for (int k = 0; k <= 10; ++k) {
+    truth.AddKnot(0.5 * k, SO2GroupElement(std::sin(0.4 * k)),
+                  Vector1d(0.3 * std::cos(0.7 * k)));
+    knot_times.push_back(0.5 * k);
+  }
+
+  // Sample the spline at 200 Hz.
+  std::vector<SplineSample<SO2GroupElement>> samples;
+  for (double t = truth.BeginTime(); t <= truth.EndTime(); t += 0.005) {
+    samples.push_back({t, truth.At(t)});
+  }
+
+  const auto fit = FitSpline(samples, knot_times);
+  ASSERT_TRUE(fit.has_value());
+  ASSERT_EQ(fit->NumKnots(), truth.NumKnots());
+  for (size_t k = 0; k < truth.NumKnots(); ++k) {
+    EXPECT_NEAR(fit->knots()[k].value.Rminus(truth.knots()[k].value)(0), 0,
+                1e-6);
+    EXPECT_NEAR(fit->knots()[k].velocity(0), truth.knots()[k].velocity(0),
+                1e-6);
+  }
+}
+
+TEST(FitSpline, ApproximatesSmoothTrajectory) {
+  // theta(t) = 2 * sin(t), which wraps around +/-pi.
+  std::vector<SplineSample<SO2GroupElement>> samples;
+  for (double t = 0; t <= 5.0; t += 0.005) {
+    samples.push_back({t, SO2GroupElement(2 * std::sin(t) + t)});
+  }
+
+  SplineFitOptions options;
+  options.knot_spacing = 0.1;
+  const auto fit = FitSpline(samples, options);
+  ASSERT_TRUE(fit.has_value());
+  EXPECT_EQ(fit->BeginTime(), 0.0);
+  for (const auto& sample : samples) {
+    EXPECT_LT(fit->At(sample.time).DistanceTo(sample.value), 1e-5);
+  }
+}
+
+TEST(FitSpline, ExposesFactorization) {
+  constexpr int kNumKnots = 5;
+  constexpr double kSpacing = 0.5;
+  std::vector<double> knot_times;
+  for (int k = 0; k < kNumKnots; ++k) knot_times.push_back(kSpacing * k);
+  std::vector<SplineSample<SO2GroupElement>> samples;
+  for (int i = 0; i <= 40; ++i) {
+    samples.push_back({0.05 * i, SO2GroupElement(std::sin(0.05 * i))});
+  }
+
+  SplineFitFactorization<SO2GroupElement> factorization;
+  const SplineFitOptions options;
+  ASSERT_TRUE(
+      FitSpline(samples, knot_times, options, &factorization).has_value());
+  ASSERT_EQ(factorization.size(), kNumKnots);
+
+  // SO2 is abelian, so the normal matrix is sum_i J_i' J_i (plus damping),
+  // where J_i holds the Hermite weights of sample i on its segment's knots.
+  Eigen::MatrixXd normal =
+      options.damping * Eigen::MatrixXd::Identity(2 * kNumKnots, 2 * kNumKnots);
+  for (const auto& sample : samples) {
+    const int segment =
+        std::min(static_cast<int>(sample.time / kSpacing), kNumKnots - 2);
+    const HermiteBasis<double> basis(
+        (sample.time - knot_times[segment]) / kSpacing);
+    Eigen::RowVectorXd jacobian = Eigen::RowVectorXd::Zero(2 * kNumKnots);
+    jacobian.segment<4>(2 * segment) << basis.h00, basis.h10 * kSpacing,
+        basis.h01, basis.h11 * kSpacing;
+    normal += jacobian.transpose() * jacobian;
+  }
+  const Eigen::MatrixXd covariance = normal.inverse();
+
+  std::vector<size_t> indices(kNumKnots);
+  for (int k = 0; k < kNumKnots; ++k) indices[k] = k;
+  const auto marginals = MarginalCovariances(factorization, indices);
+  for (int k = 0; k < kNumKnots; ++k) {
+    EXPECT_TRUE(marginals[k].isApprox(
+        covariance.block<2, 2>(2 * k, 2 * k), 1e-8));
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,171 @@
+#include "spline/spline.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lie/base/constants.h"
+#include "lie/so2/so2_group_element.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+// A non-abelian test double: 3D rotations, with just the interface that
+// non-abelian splines use.
+struct RotationGroup {
+  using Scalar = double;
+  using TangentVector = Eigen::Vector3d;
+  using Jacobian = Eigen::Matrix3d;
+  static constexpr bool IsAbelian = false;
+
+  static Eigen::Matrix3d Hat(const TangentVector& v) {
+    Eigen::Matrix3d hat;
+    hat << 0, -v(2), v(1), v(2), 0, -v(0), -v(1), v(0), 0;
+    return hat;
+  }
+  // Rodrigues' formula.
+  static RotationGroup Exp(const TangentVector& v) {
+    const double angle = v.norm();
+    const Eigen::Matrix3d hat = Hat(v);
+    if (angle < 1e-8) return {Eigen::Matrix3d::Identity() + hat};
+    return {Eigen::Matrix3d::Identity() + std::sin(angle) / angle * hat +
+            (1 - std::cos(angle)) / (angle * angle) * hat * hat};
+  }
+  TangentVector Log() const {
+    const Eigen::Matrix3d skew = (matrix - matrix.transpose()) / 2;
+    const TangentVector axis(skew(2, 1), skew(0, 2), skew(1, 0));
+    const double sin_angle = axis.norm();
+    if (sin_angle < 1e-12) return axis;
+    const double angle = std::atan2(sin_angle, (matrix.trace() - 1) / 2);
+    return angle / sin_angle * axis;
+  }
+  static Jacobian RightJacobianInverse(const TangentVector& v) {
+    const double angle = v.norm();
+    const Eigen::Matrix3d hat = Hat(v);
+    if (angle < 1e-8) return Eigen::Matrix3d::Identity() + hat / 2;
+    const Eigen::Matrix3d jacobian =
+        Eigen::Matrix3d::Identity() -
+        (1 - std::cos(angle)) / (angle * angle) * hat +
+        (angle - std::sin(angle)) / (angle * angle * angle) * hat * hat;
+    return jacobian.inverse();
+  }
+  RotationGroup Rplus(const TangentVector& v) const {
+    return {matrix * Exp(v).matrix};
+  }
+  TangentVector Rminus(const RotationGroup& rhs) const {
+    return RotationGroup{matrix.transpose() * rhs.matrix}.Log();
+  }
+
+  Eigen::Matrix3d matrix = Eigen::Matrix3d::Identity();
+};
+
+TEST(CubicHermiteSpline, InterpolatesKnots) {
+  CubicHermiteSpline<SO2GroupElement> spline;
+  spline.AddKnot(0.0, SO2GroupElement(0.1), Vector1d(0.5));
+  spline.AddKnot(1.0, SO2GroupElement(0.7), Vector1d(0.5));
+  spline.AddKnot(3.0, SO2GroupElement(-0.4), Vector1d(-1.0));
+  EXPECT_EQ(spline.NumKnots(), 3);
+  EXPECT_EQ(spline.BeginTime(), 0.0);
+  EXPECT_EQ(spline.EndTime(), 3.0);
+
+  for (const auto& knot : spline.knots()) {
+    EXPECT_EQ(spline.At(knot.time), knot.value);
+  }
+}
+
+TEST(CubicHermiteSpline, ReproducesConstantVelocity) {
+  // A constant-velocity curve is reproduced exactly by a Hermite spline whose
+  // knot velocities match the curve's.
+  constexpr double kRate = 0.8;
+  CubicHermiteSpline<SO2GroupElement> spline;
+  for (double t = 0; t <= 4.0; t += 1.0) {
+    spline.AddKnot(t, SO2GroupElement(kRate * t), Vector1d(kRate));
+  }
+  for (double t = 0; t <= 4.0; t += 0.05) {
+    EXPECT_NEAR(spline.At(t).AngleRadians(),
+                std::remainder(kRate * t, 2 * M_PI),
+                Constants<double>::kEpsilon);
+  }
+}
+
+TEST(CubicHermiteSpline, AbelianPathMatchesGenericSegment) {
+  static_assert(SO2GroupElement::IsAbelian);
+  CubicHermiteSpline<SO2GroupElement> spline;
+  // Knot values wrap around +/-pi several times.
+  for (int k = 0; k < 20; ++k) {
+    spline.AddKnot(0.5 * k, SO2GroupElement(1.3 * k), Vector1d(2.0));
+  }
+  const auto& knots = spline.knots();
+  for (double t = spline.BeginTime(); t <= spline.EndTime(); t += 0.01) {
+    const size_t index = FindSegment(knots, t);
+    EXPECT_LT(spline.At(t).DistanceTo(
+                  InterpolateHermite(knots[index], knots[index + 1], t)),
+              1e-12);
+  }
+}
+
+TEST(CubicHermiteSpline, SampleUniform) {
+  CubicHermiteSpline<SO2GroupElement> spline;
+  for (int k = 0; k < 20; ++k) {
+    spline.AddKnot(0.5 * k, SO2GroupElement(1.3 * k),
+                   Vector1d(2.0 * std::cos(k)));
+  }
+  constexpr double kStep = 1e-3;
+  constexpr size_t kNumSamples = 9000;
+  const std::vector<SO2GroupElement> samples =
+      spline.SampleUniform(/*beg_time=*/0.25, kStep, kNumSamples);
+  ASSERT_EQ(samples.size(), kNumSamples);
+  for (size_t i = 0; i < kNumSamples; ++i) {
+    EXPECT_LT(samples[i].DistanceTo(spline.At(0.25 + i * kStep)), 1e-9);
+  }
+}
+
+TEST(CubicHermiteSpline, NonAbelianVelocityIsContinuous) {
+  // Knot velocities are body-frame rates, so the central-difference body
+  // velocity of both segments meeting at an interior knot must match the knot's
+  // velocity. Each segment is differenced on its own (smooth) form, since the
+  // spline's acceleration jumps at knots.
+  CubicHermiteSpline<RotationGroup> spline;
+  for (int k = 0; k < 5; ++k) {
+    spline.AddKnot(0.5 * k,
+                   RotationGroup::Exp(Eigen::Vector3d(0.9 * k, -0.6 * k, 0.3)),
+                   Eigen::Vector3d(1.5, -0.8 * k, 2.0 - k));
+  }
+  constexpr double kStep = 1e-5;
+  const auto& knots = spline.knots();
+  for (size_t k = 1; k + 1 < knots.size(); ++k) {
+    const double time = knots[k].time;
+    for (size_t segment : {k - 1, k}) {
+      const auto at = [&](double t) {
+        return InterpolateHermite(knots[segment], knots[segment + 1], t);
+      };
+      const Eigen::Vector3d velocity =
+          at(time - kStep).Rminus(at(time + kStep)) / (2 * kStep);
+      EXPECT_TRUE(velocity.isApprox(knots[k].velocity, 1e-8))
+          << velocity.transpose() << " vs " << knots[k].velocity.transpose();
+    }
+  }
+
+  // Uniform sampling takes the same segment form.
+  const std::vector<RotationGroup> samples =
+      spline.SampleUniform(/*beg_time=*/0.0, /*step=*/0.01, /*n=*/201);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_LT(samples[i].Rminus(spline.At(0.01 * i)).norm(), 1e-12);
+  }
+}
+
+TEST(CubicHermiteSpline, FindSegment) {
+  CubicHermiteSpline<SO2GroupElement> spline;
+  for (double t = 0; t <= 4.0; t += 1.0) {
+    spline.AddKnot(t, SO2GroupElement(), Vector1d(0));
+  }
+  EXPECT_EQ(FindSegment(spline.knots(), 0.0), 0);
+  EXPECT_EQ(FindSegment(spline.knots(), 0.5), 0);
+  EXPECT_EQ(FindSegment(spline.knots(), 1.0), 1);
+  EXPECT_EQ(FindSegment(spline.knots(), 3.5), 3);
+  EXPECT_EQ(FindSegment(spline.knots(), 4.0), 3);
+}
+
+}  // namespace mana
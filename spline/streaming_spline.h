@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "spline/spline.h"
+#include "utils/ring_buffer.h"
+
+namespace mana {
+
+// An append-only cubic Hermite spline with bounded memory, intended for
+// estimators that run indefinitely. Knots are stored in a fixed-capacity ring
+// buffer: new knots are pushed at the head, and knots that fall outside of a
+// sliding time horizon (or that no longer fit in the buffer) are evicted from
+// the tail. All storage is allocated at construction; adding knots and
+// evaluating the spline never allocate.
+template <typename Group>
+class StreamingSpline {
+ public:
+  using Scalar = typename Group::Scalar;
+  using TangentVector = typename Group::TangentVector;
+  using Knot = SplineKnot<Group>;
+
+  // Construct with room for `capacity` knots (at least 2). Knots are evicted
+  // once they are no longer needed to evaluate the spline within `horizon`
+  // seconds of the newest knot.
+  StreamingSpline(size_t capacity, Scalar horizon);
+
+  // Append a knot at the head of the spline, evicting stale knots from the
+  // tail. Knot times must be strictly increasing.
+  void AddKnot(Scalar time, Group value, TangentVector velocity);
+
+  // Evaluate the spline at the provided time, which must lie within the live
+  // window [BeginTime(), EndTime()].
+  Group At(Scalar time) const;
+
+  // Return the time range of the live window.
+  Scalar BeginTime() const;
+  Scalar EndTime() const;
+
+  // Return the number of knots currently held, and the maximum number held.
+  size_t NumKnots() const;
+  size_t Capacity() const;
+
+  // Return the time horizon of the live window.
+  Scalar Horizon() const;
+
+  // Access the underlying knots, ordered from oldest to newest.
+  const RingBuffer<Knot>& knots() const;
+
+ private:
+  RingBuffer<Knot> knots_;
+  Scalar horizon_;
+};
+
+template <typename Group>
+StreamingSpline<Group>::StreamingSpline(size_t capacity, Scalar horizon)
+    : knots_(capacity), horizon_(horizon) {
+  assert(capacity >= 2);
+  assert(horizon >= 0);
+}
+
+template <typename Group>
+void StreamingSpline<Group>::AddKnot(Scalar time, Group value,
+                                     TangentVector velocity) {
+  assert(knots_.empty() || time > knots_.back().time);
+  if (knots_.full()) knots_.PopFront();
+  knots_.PushBack(Knot{time, std::move(value), std::move(velocity)});
+
+  // Evict knots from the tail as long as the segment after them still covers
+  // the start of the horizon.
+  const Scalar horizon_begin = time - horizon_;
+  while (knots_.size() > 2 && knots_[1].time <= horizon_begin) {
+    knots_.PopFront();
+  }
+}
+
+template <typename Group>
+Group StreamingSpline<Group>::At(Scalar time) const {
+  assert(!knots_.empty());
+  assert(time >= BeginTime() && time <= EndTime());
+  if (knots_.size() == 1) return knots_.front().value;
+  const size_t index = FindSegment(knots_, time);
+  return InterpolateHermite(knots_[index], knots_[index + 1], time);
+}
+
+template <typename Group>
+typename StreamingSpline<Group>::Scalar StreamingSpline<Group>::BeginTime()
+    const {
+  assert(!knots_.empty());
+  return knots_.front().time;
+}
+
+template <typename Group>
+typename StreamingSpline<Group>::Scalar StreamingSpline<Group>::EndTime()
+    const {
+  assert(!knots_.empty());
+  return knots_.back().time;
+}
+
+template <typename Group>
+size_t StreamingSpline<Group>::NumKnots() const {
+  return knots_.size();
+}
+
+template <typename Group>
+size_t StreamingSpline<Group>::Capacity() const {
+  return knots_.capacity();
+}
+
+template <typename Group>
+typename StreamingSpline<Group>::Scalar StreamingSpline<Group>::Horizon()
+    const {
+  return horizon_;
+}
+
+template <typename Group>
+const RingBuffer<typename StreamingSpline<Group>::Knot>&
+StreamingSpline<Group>::knots() const {
+  return knots_;
+}
+
+}  // namespace mana
@@ -0,0 +1,49 @@
+#include "spline/streaming_spline.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "lie/so2/so2_group_element.h"
+#include "spline/spline.h"
+
+namespace mana {
+
+using Vector1d = SO2GroupElement::TangentVector;
+
+TEST(StreamingSpline, EvictsOutsideHorizon) {
+  StreamingSpline<SO2GroupElement> spline(/*capacity=*/16, /*horizon=*/2.5);
+  for (int i = 0; i <= 10; ++i) {
+    spline.AddKnot(i, SO2GroupElement(0.1 * i), Vector1d(0.1));
+  }
+  // The live window must still cover [10 - 2.5, 10].
+  EXPECT_EQ(spline.BeginTime(), 7.0);
+  EXPECT_EQ(spline.EndTime(), 10.0);
+  EXPECT_EQ(spline.NumKnots(), 4);
+  EXPECT_EQ(spline.Capacity(), 16);
+}
+
+TEST(StreamingSpline, EvictsAtCapacity) {
+  StreamingSpline<SO2GroupElement> spline(/*capacity=*/4, /*horizon=*/100.0);
+  for (int i = 0; i < 1000; ++i) {
+    spline.AddKnot(i, SO2GroupElement(0.01 * i), Vector1d(0.01));
+    EXPECT_LE(spline.NumKnots(), 4);
+  }
+  EXPECT_EQ(spline.BeginTime(), 996.0);
+  EXPECT_EQ(spline.EndTime(), 999.0);
+}
+
+TEST(StreamingSpline, MatchesBatchSpline) {
+  StreamingSpline<SO2GroupElement> streaming(/*capacity=*/8, /*horizon=*/3.0);
+  CubicHermiteSpline<SO2GroupElement> batch;
+  for (int i = 0; i < 50; ++i) {
+    const SO2GroupElement value(0.3 * std::sin(0.2 * i));
+    const Vector1d velocity(0.06 * std::cos(0.2 * i));
+    streaming.AddKnot(0.5 * i, value, velocity);
+    batch.AddKnot(0.5 * i, value, velocity);
+  }
+  for (double t = streaming.BeginTime(); t <= streaming.EndTime(); t += 0.01) {
+    EXPECT_EQ(streaming.At(t), batch.At(t));
+  }
+}
+
+}  // namespace mana
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "spline/spline.h"
+
+namespace mana {
+
+// Binary trajectory file format for cubic Hermite spline knots, designed to be
+// memory mapped and queried in place (see `MmapSpline<>`).
+//
+// Layout (host byte order). Every section starts at a multiple of
+// `kTrajectoryFileAlignment` bytes from the start of the file:
+//   TrajectoryFileHeader header;
+//   Scalar timestamps[num_knots];
+//   Scalar values[num_knots][storage_dimension];
+//   Scalar velocities[num_knots][tangent_dimension];
+//
+// Group values are written in the group's own storage layout (e.g.
+// [cos(theta), sin(theta)] for SO2), so that the reader never has to convert
+// them. Groups written to this format must provide:
+// - static constexpr int StorageDimension;
+// - static Group FromStorage(const Scalar* storage);
+// - void ToStorage(Scalar* storage) const;
+
+// Section alignment within the file, in bytes.
+inline constexpr size_t kTrajectoryFileAlignment = 64;
+
+// Current format version. Bump on any layout change.
+inline constexpr uint32_t kTrajectoryFileVersion = 1;
+
+// Magic bytes at the start of every trajectory file.
+inline constexpr char kTrajectoryFileMagic[8] = {'M', 'A', 'N', 'A',
+                                                 'T', 'R', 'J', '\0'};
+
+struct alignas(kTrajectoryFileAlignment) TrajectoryFileHeader {
+  char magic[8];
+  uint32_t version;
+  // Size of each scalar in bytes, e.g. 8 for double.
+  uint32_t scalar_size;
+  // Number of scalars per group value, and per velocity.
+  uint32_t storage_dimension;
+  uint32_t tangent_dimension;
+  uint64_t num_knots;
+  // Byte offsets of each section from the start of the file.
+  uint64_t timestamps_offset;
+  uint64_t values_offset;
+  uint64_t velocities_offset;
+  // Total file size in bytes.
+  uint64_t file_size;
+};
+static_assert(sizeof(TrajectoryFileHeader) == kTrajectoryFileAlignment);
+
+// Round `offset` up to the next multiple of `kTrajectoryFileAlignment`.
+inline constexpr uint64_t AlignTrajectoryOffset(uint64_t offset) {
+  return (offset + kTrajectoryFileAlignment - 1) /
+         kTrajectoryFileAlignment * kTrajectoryFileAlignment;
+}
+
+// Build the header describing a trajectory of `num_knots` knots of `Group`.
+template <typename Group>
+TrajectoryFileHeader MakeTrajectoryFileHeader(uint64_t num_knots);
+
+// Check that `header` is a well-formed header for a trajectory of `Group`
+// knots, stored in a file of `file_size` bytes. The header is untrusted: a
+// knot count too large for the file is rejected before any offset is derived
+// from it.
+template <typename Group>
+bool IsValidTrajectoryFileHeader(const TrajectoryFileHeader& header,
+                                 size_t file_size);
+
+// Write the knots of `spline` to `path`. Returns false on I/O failure.
+template <typename Group>
+bool WriteTrajectoryFile(const std::string& path,
+                         const CubicHermiteSpline<Group>& spline);
+
+template <typename Group>
+TrajectoryFileHeader MakeTrajectoryFileHeader(uint64_t num_knots) {
+  using Scalar = typename Group::Scalar;
+  TrajectoryFileHeader header = {};
+  std::memcpy(header.magic, kTrajectoryFileMagic, sizeof(header.magic));
+  header.version = kTrajectoryFileVersion;
+  header.scalar_size = sizeof(Scalar);
+  header.storage_dimension = Group::StorageDimension;
+  header.tangent_dimension = Group::Dimension;
+  header.num_knots = num_knots;
+  header.timestamps_offset = AlignTrajectoryOffset(sizeof(header));
+  header.values_offset = AlignTrajectoryOffset(header.timestamps_offset +
+                                               num_knots * sizeof(Scalar));
+  header.velocities_offset = AlignTrajectoryOffset(
+      header.values_offset +
+      num_knots * header.storage_dimension * sizeof(Scalar));
+  header.file_size = header.velocities_offset +
+                     num_knots * header.tangent_dimension * sizeof(Scalar);
+  return header;
+}
+
+template <typename Group>
+bool IsValidTrajectoryFileHeader(const TrajectoryFileHeader& header,
+                                 size_t file_size) {
+  if (std::memcmp(header.magic, kTrajectoryFileMagic, sizeof(header.magic))) {
+    return false;
+  }
+  if (header.version != kTrajectoryFileVersion) return false;
+  if (header.file_size != file_size) return false;
+  // Bound the (untrusted) knot count by the space its sections would take, so
+  // that computing their offsets below cannot overflow.
+  if (file_size < sizeof(header)) return false;
+  constexpr uint64_t kKnotSize =
+      (1 + Group::StorageDimension + Group::Dimension) *
+      sizeof(typename Group::Scalar);
+  if (header.num_knots > (file_size - sizeof(header)) / kKnotSize) {
+    return false;
+  }
+  // All remaining fields are fully determined by the group and knot count.
+  const TrajectoryFileHeader expected =
+      MakeTrajectoryFileHeader<Group>(header.num_knots);
+  return std::memcmp(&header, &expected, sizeof(header)) == 0;
+}
+
+template <typename Group>
+bool WriteTrajectoryFile(const std::string& path,
+                         const CubicHermiteSpline<Group>& spline) {
+  using Scalar = typename Group::Scalar;
+  const auto& knots = spline.knots();
+  const TrajectoryFileHeader header =
+      MakeTrajectoryFileHeader<Group>(knots.size());
+
+  // Assemble the file in memory, so that alignment padding is zero-filled.
+  std::vector<char> buffer(header.file_size, 0);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  char* timestamps = buffer.data() + header.timestamps_offset;
+  char* values = buffer.data() + header.values_offset;
+  char* velocities = buffer.data() + header.velocities_offset;
+  Scalar storage[Group::StorageDimension];
+  for (size_t i = 0; i < knots.size(); ++i) {
+    std::memcpy(timestamps + i * sizeof(Scalar), &knots[i].time,
+                sizeof(Scalar));
+    knots[i].value.ToStorage(storage);
+    std::memcpy(values + i * sizeof(storage), storage, sizeof(storage));
+    std::memcpy(velocities + i * Group::Dimension * sizeof(Scalar),
+                knots[i].velocity.data(), Group::Dimension * sizeof(Scalar));
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) return false;
+  file.write(buffer.data(), buffer.size());
+  return static_cast<bool>(file);
+}
+
+}  // namespace mana
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace mana {
+
+// Prevent the compiler from optimizing away the computation of `value`.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Return the mean wall-clock time, in nanoseconds, of `iterations` calls to
+// `fn()`, after an untimed warm-up of `iterations / 10` calls.
+template <typename Fn>
+double MeasureNanoseconds(Fn&& fn, size_t iterations) {
+  for (size_t i = 0; i < iterations / 10; ++i) fn();
+  const auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) fn();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() /
+         iterations;
+}
+
+// Print one row of a benchmark report: a label, the time per operation, and
+// the speedup relative to `baseline_nanoseconds`.
+inline void PrintBenchmark(const char* label, double nanoseconds,
+                           double baseline_nanoseconds) {
+  std::printf("%-40s %10.2f ns/op %8.2fx\n", label, nanoseconds,
+              baseline_nanoseconds / nanoseconds);
+}
+
+}  // namespace mana
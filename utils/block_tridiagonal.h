@@ -0,0 +1,226 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace mana {
+
+// A symmetric block-tridiagonal matrix with square N x N blocks:
+//
+//   | D0   U0                 |
+//   | U0'  D1   U1            |
+//   |      U1'  D2   ...      |
+//   |           ...  ... Un-2 |
+//   |               Un-2' Dn-1|
+//
+// Only the diagonal blocks and the blocks above the diagonal are stored.
+template <typename Scalar, int N>
+struct BlockTridiagonalMatrix {
+  using Block = Eigen::Matrix<Scalar, N, N>;
+  using Vector = Eigen::Matrix<Scalar, N, 1>;
+
+  // Construct a zero matrix with `num_blocks` blocks along the diagonal.
+  explicit BlockTridiagonalMatrix(size_t num_blocks)
+      : diagonal(num_blocks, Block::Zero()),
+        upper(num_blocks > 0 ? num_blocks - 1 : 0, Block::Zero()) {}
+
+  // Return the number of blocks along the diagonal.
+  size_t size() const { return diagonal.size(); }
+
+  // Diagonal blocks D_i = A(i, i).
+  std::vector<Block> diagonal;
+  // Off-diagonal blocks U_i = A(i, i + 1) = A(i + 1, i)'.
+  std::vector<Block> upper;
+};
+
+// The block LDL' factorization of a symmetric positive definite
+// block-tridiagonal matrix A computed by block Thomas elimination:
+//   A = (I + C)' S (I + C),
+// with S = diag(S_0, ..., S_{n-1}) the Schur complement pivots,
+//   S_i = D_i - U_{i-1}' S_{i-1}^{-1} U_{i-1},
+// and C strictly block upper-bidiagonal, with blocks C_i = S_i^{-1} U_i.
+template <typename Scalar, int N>
+struct BlockTridiagonalFactorization {
+  using Block = typename BlockTridiagonalMatrix<Scalar, N>::Block;
+
+  // Return the number of blocks along the diagonal.
+  size_t size() const { return pivots.size(); }
+
+  // Factorizations of the pivots S_i.
+  std::vector<Eigen::LDLT<Block>> pivots;
+  // Factors C_i = S_i^{-1} U_i.
+  std::vector<Block> factors;
+};
+
+// Factor a symmetric positive definite block-tridiagonal matrix, in O(n * N^3)
+// for n blocks of size N. Returns false if a pivot block is not positive
+// definite, in which case `factorization` is unspecified.
+template <typename Scalar, int N>
+bool FactorBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    BlockTridiagonalFactorization<Scalar, N>& factorization);
+
+// Solve A * x = b for a symmetric positive definite block-tridiagonal matrix A,
+// using block Thomas elimination. Costs O(n * N^3) for n blocks of size N, in
+// contrast to O((n * N)^3) for a dense solve. Returns false if a pivot block is
+// not positive definite, in which case `solution` is unspecified.
+template <typename Scalar, int N>
+bool SolveBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    const std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& rhs,
+    std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& solution);
+
+// As above, reusing a factorization of `matrix`, in O(n * N^2).
+template <typename Scalar, int N>
+void SolveBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    const BlockTridiagonalFactorization<Scalar, N>& factorization,
+    const std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& rhs,
+    std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& solution);
+
+// Return the blocks of the inverse (e.g. the covariance, when A is an
+// information matrix) on the sparsity pattern of the factor, i.e. its diagonal
+// and first off-diagonal blocks, without forming the (dense) inverse. Uses the
+// sparse-inverse (Takahashi) recursion, from the last block backwards:
+//   P_{n-1,n-1} = S_{n-1}^{-1},
+//   P_{i,i+1} = -C_i P_{i+1,i+1},
+//   P_{i,i} = S_i^{-1} - P_{i,i+1} C_i'.
+// Costs O(n * N^3), proportional to the fill of the factor.
+template <typename Scalar, int N>
+BlockTridiagonalMatrix<Scalar, N> SparseInverse(
+    const BlockTridiagonalFactorization<Scalar, N>& factorization);
+
+// Return the diagonal blocks P_{i,i} of the inverse for each i in `indices`
+// (in any order), e.g. the marginal covariances of a few knots. Runs the
+// recursion of `SparseInverse()` only down to the smallest index, keeping a
+// single block of the inverse at a time.
+template <typename Scalar, int N>
+std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Block>
+MarginalCovariances(
+    const BlockTridiagonalFactorization<Scalar, N>& factorization,
+    const std::vector<size_t>& indices);
+
+template <typename Scalar, int N>
+bool FactorBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    BlockTridiagonalFactorization<Scalar, N>& factorization) {
+  using Block = typename BlockTridiagonalMatrix<Scalar, N>::Block;
+  const size_t n = matrix.size();
+  factorization.pivots.resize(n);
+  factorization.factors.resize(n > 0 ? n - 1 : 0);
+  for (size_t i = 0; i < n; ++i) {
+    Block schur = matrix.diagonal[i];
+    if (i > 0) {
+      schur.noalias() -=
+          matrix.upper[i - 1].transpose() * factorization.factors[i - 1];
+    }
+    Eigen::LDLT<Block>& pivot = factorization.pivots[i];
+    pivot.compute(schur);
+    if (pivot.info() != Eigen::Success ||
+        !(pivot.vectorD().array() > 0).all()) {
+      return false;
+    }
+    if (i + 1 < n) factorization.factors[i] = pivot.solve(matrix.upper[i]);
+  }
+  return true;
+}
+
+template <typename Scalar, int N>
+bool SolveBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    const std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& rhs,
+    std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& solution) {
+  BlockTridiagonalFactorization<Scalar, N> factorization;
+  if (!FactorBlockTridiagonal(matrix, factorization)) return false;
+  SolveBlockTridiagonal(matrix, factorization, rhs, solution);
+  return true;
+}
+
+template <typename Scalar, int N>
+void SolveBlockTridiagonal(
+    const BlockTridiagonalMatrix<Scalar, N>& matrix,
+    const BlockTridiagonalFactorization<Scalar, N>& factorization,
+    const std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& rhs,
+    std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Vector>& solution) {
+  const size_t n = matrix.size();
+  assert(factorization.size() == n);
+  assert(rhs.size() == n);
+  solution.resize(n);
+
+  // Forward elimination. After step i, row i reads x_i + C_i x_{i+1} = d_i,
+  // where d_i is stored in `solution`.
+  for (size_t i = 0; i < n; ++i) {
+    typename BlockTridiagonalMatrix<Scalar, N>::Vector residual = rhs[i];
+    if (i > 0) {
+      residual.noalias() -= matrix.upper[i - 1].transpose() * solution[i - 1];
+    }
+    solution[i] = factorization.pivots[i].solve(residual);
+  }
+
+  // Back substitution.
+  for (size_t i = n; i-- > 1;) {
+    solution[i - 1].noalias() -= factorization.factors[i - 1] * solution[i];
+  }
+}
+
+template <typename Scalar, int N>
+BlockTridiagonalMatrix<Scalar, N> SparseInverse(
+    const BlockTridiagonalFactorization<Scalar, N>& factorization) {
+  using Block = typename BlockTridiagonalMatrix<Scalar, N>::Block;
+  const size_t n = factorization.size();
+  BlockTridiagonalMatrix<Scalar, N> inverse(n);
+  if (n == 0) return inverse;
+  inverse.diagonal[n - 1] =
+      factorization.pivots[n - 1].solve(Block::Identity());
+  for (size_t i = n - 1; i-- > 0;) {
+    const Block& factor = factorization.factors[i];
+    inverse.upper[i].noalias() = -factor * inverse.diagonal[i + 1];
+    inverse.diagonal[i] = factorization.pivots[i].solve(Block::Identity());
+    inverse.diagonal[i].noalias() -= inverse.upper[i] * factor.transpose();
+  }
+  return inverse;
+}
+
+template <typename Scalar, int N>
+std::vector<typename BlockTridiagonalMatrix<Scalar, N>::Block>
+MarginalCovariances(
+    const BlockTridiagonalFactorization<Scalar, N>& factorization,
+    const std::vector<size_t>& indices) {
+  using Block = typename BlockTridiagonalMatrix<Scalar, N>::Block;
+  const size_t n = factorization.size();
+  std::vector<Block> marginals(indices.size());
+  if (indices.empty()) return marginals;
+
+  // Positions in `indices`, in decreasing order of index.
+  std::vector<size_t> order(indices.size());
+  for (size_t k = 0; k < order.size(); ++k) {
+    assert(indices[k] < n);
+    order[k] = k;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return indices[lhs] > indices[rhs];
+  });
+
+  // Walk the recursion down from the last block, keeping P_{i,i}, and copy it
+  // out whenever i is requested.
+  auto next = order.begin();
+  Block marginal = factorization.pivots[n - 1].solve(Block::Identity());
+  for (size_t i = n - 1;; --i) {
+    if (i < n - 1) {
+      const Block& factor = factorization.factors[i];
+      const Block cross = -factor * marginal;
+      marginal = factorization.pivots[i].solve(Block::Identity());
+      marginal.noalias() -= cross * factor.transpose();
+    }
+    for (; next != order.end() && indices[*next] == i; ++next) {
+      marginals[*next] = marginal;
+    }
+    if (next == order.end()) break;
+  }
+  return marginals;
+}
+
+}  // namespace mana
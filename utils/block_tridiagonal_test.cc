@@ -0,0 +1,130 @@
+#include "utils/block_tridiagonal.h"
+
+#include <Eigen/Dense>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace mana {
+
+TEST(BlockTridiagonal, MatchesDenseSolve) {
+  constexpr int kBlockDim = 3;
+  constexpr int kNumBlocks = 20;
+  constexpr int kSize = kBlockDim * kNumBlocks;
+  using Matrix = BlockTridiagonalMatrix<double, kBlockDim>;
+
+  // Build a random SPD block-tridiagonal matrix as J'J + I, where J is block
+  // bidiagonal.
+  std::srand(0);
+  Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(kSize, kSize);
+  for (int i = 0; i < kNumBlocks; ++i) {
+    jacobian.block<kBlockDim, kBlockDim>(i * kBlockDim, i * kBlockDim)
+        .setRandom();
+    if (i + 1 < kNumBlocks) {
+      jacobian.block<kBlockDim, kBlockDim>(i * kBlockDim, (i + 1) * kBlockDim)
+          .setRandom();
+    }
+  }
+  const Eigen::MatrixXd dense =
+      jacobian.transpose() * jacobian + Eigen::MatrixXd::Identity(kSize, kSize);
+  const Eigen::VectorXd b = Eigen::VectorXd::Random(kSize);
+
+  Matrix matrix(kNumBlocks);
+  std::vector<Matrix::Vector> rhs(kNumBlocks);
+  for (int i = 0; i < kNumBlocks; ++i) {
+    matrix.diagonal[i] =
+        dense.block<kBlockDim, kBlockDim>(i * kBlockDim, i * kBlockDim);
+    if (i + 1 < kNumBlocks) {
+      matrix.upper[i] =
+          dense.block<kBlockDim, kBlockDim>(i * kBlockDim, (i + 1) * kBlockDim);
+    }
+    rhs[i] = b.segment<kBlockDim>(i * kBlockDim);
+  }
+
+  std::vector<Matrix::Vector> solution;
+  ASSERT_TRUE(SolveBlockTridiagonal(matrix, rhs, solution));
+  const Eigen::VectorXd expected = dense.ldlt().solve(b);
+  for (int i = 0; i < kNumBlocks; ++i) {
+    EXPECT_LT((solution[i] - expected.segment<kBlockDim>(i * kBlockDim))
+                  .cwiseAbs()
+                  .maxCoeff(),
+              1e-10);
+  }
+}
+
+// Build a random SPD block-tridiagonal matrix of `num_blocks` blocks of size
+// N, as J'J + I for a random block-bidiagonal J.
+template <int N>
+Eigen::MatrixXd RandomBlockTridiagonal(int num_blocks) {
+  const int size = N * num_blocks;
+  Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(size, size);
+  for (int i = 0; i < num_blocks; ++i) {
+    jacobian.block<N, N>(i * N, i * N).setRandom();
+    if (i + 1 < num_blocks) {
+      jacobian.block<N, N>(i * N, (i + 1) * N).setRandom();
+    }
+  }
+  return jacobian.transpose() * jacobian +
+         Eigen::MatrixXd::Identity(size, size);
+}
+
+// Copy the block-tridiagonal part of a dense matrix.
+template <int N>
+BlockTridiagonalMatrix<double, N> ToBlockTridiagonal(
+    const Eigen::MatrixXd& dense) {
+  const int num_blocks = dense.rows() / N;
+  BlockTridiagonalMatrix<double, N> matrix(num_blocks);
+  for (int i = 0; i < num_blocks; ++i) {
+    matrix.diagonal[i] = dense.block<N, N>(i * N, i * N);
+    if (i + 1 < num_blocks) {
+      matrix.upper[i] = dense.block<N, N>(i * N, (i + 1) * N);
+    }
+  }
+  return matrix;
+}
+
+TEST(BlockTridiagonal, SparseInverse) {
+  constexpr int kBlockDim = 3;
+  constexpr int kNumBlocks = 20;
+  using Matrix = BlockTridiagonalMatrix<double, kBlockDim>;
+
+  std::srand(0);
+  const Eigen::MatrixXd dense = RandomBlockTridiagonal<kBlockDim>(kNumBlocks);
+  const Eigen::MatrixXd expected = dense.inverse();
+  BlockTridiagonalFactorization<double, kBlockDim> factorization;
+  ASSERT_TRUE(FactorBlockTridiagonal(ToBlockTridiagonal<kBlockDim>(dense),
+                                     factorization));
+
+  const Matrix inverse = SparseInverse(factorization);
+  for (int i = 0; i < kNumBlocks; ++i) {
+    EXPECT_TRUE(inverse.diagonal[i].isApprox(
+        expected.block<kBlockDim, kBlockDim>(i * kBlockDim, i * kBlockDim),
+        1e-10));
+    if (i + 1 < kNumBlocks) {
+      EXPECT_TRUE(inverse.upper[i].isApprox(
+          expected.block<kBlockDim, kBlockDim>(i * kBlockDim,
+                                               (i + 1) * kBlockDim),
+          1e-10));
+    }
+  }
+
+  const std::vector<size_t> indices = {12, 3, 19, 12};
+  const std::vector<Matrix::Block> marginals =
+      MarginalCovariances(factorization, indices);
+  ASSERT_EQ(marginals.size(), indices.size());
+  for (size_t k = 0; k < indices.size(); ++k) {
+    EXPECT_TRUE(marginals[k].isApprox(inverse.diagonal[indices[k]], 1e-12));
+  }
+}
+
+TEST(BlockTridiagonal, RejectsIndefinite) {
+  BlockTridiagonalMatrix<double, 2> matrix(2);
+  matrix.diagonal[0] = Eigen::Matrix2d::Identity();
+  matrix.diagonal[1] = -Eigen::Matrix2d::Identity();
+  std::vector<Eigen::Vector2d> rhs(2, Eigen::Vector2d::Ones());
+  std::vector<Eigen::Vector2d> solution;
+  EXPECT_FALSE(SolveBlockTridiagonal(matrix, rhs, solution));
+}
+
+}  // namespace mana
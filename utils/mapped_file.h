@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace mana {
+
+// A read-only memory mapping of an entire file. The mapping is released when
+// the object is destroyed. Move-only.
+class MappedFile {
+ public:
+  // Map the file at `path` into memory. Returns std::nullopt if the file cannot
+  // be opened or mapped, or if it is empty.
+  static std::optional<MappedFile> Open(const std::string& path);
+
+  MappedFile(MappedFile&& rhs);
+  MappedFile& operator=(MappedFile&& rhs);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  // Return the start of the mapped region. The mapping is page-aligned.
+  const void* data() const;
+
+  // Return the size of the mapped region, in bytes.
+  size_t size() const;
+
+ private:
+  MappedFile(const void* data, size_t size);
+
+  // Unmap the region, if one is held.
+  void Reset();
+
+  const void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace mana
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mana {
+
+// Execution policies for the parallel algorithms below. Work over an index
+// range [0, n) is split into consecutive chunks of `grain_size` indices. The
+// chunking only depends on the grain size (never on the number of threads), so
+// reductions with the same grain size produce bitwise identical results under
+// either policy, on any number of threads.
+
+// Process all chunks in order on the calling thread.
+struct SequentialExecution {
+  size_t grain_size = 1024;
+};
+
+// Process chunks concurrently on the calling thread and `num_threads - 1`
+// workers of the shared `ThreadPool`, each claiming the next unprocessed chunk
+// until none remain. The workers persist across calls, so a call costs
+// queueing a task per worker and waking it, not creating threads. Unlike
+// sequential execution, it does allocate: the tasks' shared state and queue
+// entries, and the partial results of a reduction.
+struct ParallelExecution {
+  // Number of threads to use; zero uses std::thread::hardware_concurrency().
+  size_t num_threads = 0;
+  size_t grain_size = 1024;
+};
+
+// A fixed set of worker threads running queued tasks in FIFO order. Workers
+// are only added, never removed, and are joined on destruction after the
+// queue drains.
+class ThreadPool {
+ public:
+  // Return the process-wide pool used by `ParallelExecution`, which starts
+  // with no workers.
+  static ThreadPool& Shared();
+
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Start workers until there are at least `num_workers`.
+  void Reserve(size_t num_workers);
+
+  // Queue `task` to run on a worker.
+  void Schedule(std::function<void()> task);
+
+  // Return the number of workers.
+  size_t size() const;
+
+ private:
+  // Run queued tasks until the pool is destroyed.
+  void Work();
+
+  mutable std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+  bool stopping_ = false;
+};
+
+// Call `fn(begin, end)` for each chunk [begin, end) of [0, n).
+template <typename Fn>
+void ParallelFor(const SequentialExecution& policy, size_t n, Fn&& fn);
+template <typename Fn>
+void ParallelFor(const ParallelExecution& policy, size_t n, Fn&& fn);
+
+// Reduce [0, n) deterministically: each chunk is reduced to a partial result
+// with `reduce_chunk(begin, end)`, and the partial results are folded in index
+// order, starting from `init`, with `combine(accumulated, partial)`. Since
+// partial results are never reordered, `combine` need only be associative
+// (e.g. composition in a non-abelian group), not commutative. Sequentially,
+// each partial result is folded in as soon as it is produced, so beyond what
+// `reduce_chunk` and `combine` do, the reduction does not allocate.
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduce(const SequentialExecution& policy, size_t n, T init,
+                 ChunkFn&& reduce_chunk, CombineFn&& combine);
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduce(const ParallelExecution& policy, size_t n, T init,
+                 ChunkFn&& reduce_chunk, CombineFn&& combine);
+
+template <typename Fn>
+void ParallelFor(const SequentialExecution& policy, size_t n, Fn&& fn) {
+  const size_t grain_size = std::max<size_t>(1, policy.grain_size);
+  for (size_t begin = 0; begin < n; begin += grain_size) {
+    fn(begin, std::min(n, begin + grain_size));
+  }
+}
+
+template <typename Fn>
+void ParallelFor(const ParallelExecution& policy, size_t n, Fn&& fn) {
+  const size_t grain_size = std::max<size_t>(1, policy.grain_size);
+  const size_t num_chunks = (n + grain_size - 1) / grain_size;
+  const size_t hardware_threads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  const size_t num_threads =
+      std::min(num_chunks, policy.num_threads > 0 ? policy.num_threads
+                                                  : hardware_threads);
+  if (num_threads <= 1) {
+    ParallelFor(SequentialExecution{grain_size}, n, fn);
+    return;
+  }
+
+  // The calling thread waits for every chunk to finish, not for every queued
+  // task to run: a task that only starts after all chunks were claimed (e.g.
+  // when the workers are busy with an enclosing `ParallelFor()`) touches
+  // nothing but `state`, which it shares ownership of.
+  struct State {
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> num_finished{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  const auto state = std::make_shared<State>();
+  const auto worker = [state, num_chunks, grain_size, n, &fn] {
+    for (size_t chunk = state->next_chunk++; chunk < num_chunks;
+         chunk = state->next_chunk++) {
+      const size_t begin = chunk * grain_size;
+      fn(begin, std::min(n, begin + grain_size));
+      if (++state->num_finished == num_chunks) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished.notify_all();
+      }
+    }
+  };
+  ThreadPool& pool = ThreadPool::Shared();
+  pool.Reserve(num_threads - 1);
+  for (size_t i = 0; i + 1 < num_threads; ++i) pool.Schedule(worker);
+  worker();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock,
+                       [&] { return state->num_finished == num_chunks; });
+}
+
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduce(const SequentialExecution& policy, size_t n, T init,
+                 ChunkFn&& reduce_chunk, CombineFn&& combine) {
+  T result = std::move(init);
+  ParallelFor(policy, n, [&](size_t begin, size_t end) {
+    result = combine(std::move(result), reduce_chunk(begin, end));
+  });
+  return result;
+}
+
+template <typename T, typename ChunkFn, typename CombineFn>
+T ParallelReduce(const ParallelExecution& policy, size_t n, T init,
+                 ChunkFn&& reduce_chunk, CombineFn&& combine) {
+  const size_t grain_size = std::max<size_t>(1, policy.grain_size);
+  std::vector<std::optional<T>> partials((n + grain_size - 1) / grain_size);
+  ParallelFor(policy, n, [&](size_t begin, size_t end) {
+    partials[begin / grain_size].emplace(reduce_chunk(begin, end));
+  });
+  T result = std::move(init);
+  for (std::optional<T>& partial : partials) {
+    result = combine(std::move(result), std::move(*partial));
+  }
+  return result;
+}
+
+}  // namespace mana
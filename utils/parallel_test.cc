@@ -0,0 +1,87 @@
+#include "utils/parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace mana {
+
+TEST(Parallel, ParallelForVisitsEachIndexOnce) {
+  constexpr size_t kSize = 10007;
+  std::vector<std::atomic<int>> visits(kSize);
+  ParallelFor(ParallelExecution{/*num_threads=*/4, /*grain_size=*/100}, kSize,
+              [&](size_t begin, size_t end) {
+                EXPECT_EQ(begin % 100, 0);
+                EXPECT_LE(end - begin, 100);
+                for (size_t i = begin; i < end; ++i) ++visits[i];
+              });
+  for (const std::atomic<int>& count : visits) EXPECT_EQ(count, 1);
+}
+
+TEST(Parallel, ParallelForReusesWorkers) {
+  const ParallelExecution policy{/*num_threads=*/4, /*grain_size=*/1};
+  size_t num_workers = 0;
+  for (int call = 0; call < 100; ++call) {
+    std::atomic<int> sum{0};
+    ParallelFor(policy, 10, [&](size_t begin, size_t) { sum += begin; });
+    EXPECT_EQ(sum, 45);
+    if (call == 0) num_workers = ThreadPool::Shared().size();
+  }
+  EXPECT_GE(num_workers, 3);
+  EXPECT_EQ(ThreadPool::Shared().size(), num_workers);
+}
+
+TEST(Parallel, NestedParallelForCompletes) {
+  // The inner calls queue tasks behind the outer ones, which occupy every
+  // worker; the calling threads must finish the inner loops themselves.
+  const ParallelExecution policy{/*num_threads=*/4, /*grain_size=*/1};
+  std::vector<std::atomic<int>> visits(8 * 8);
+  ParallelFor(policy, 8, [&](size_t outer, size_t) {
+    ParallelFor(policy, 8, [&](size_t inner, size_t) {
+      ++visits[8 * outer + inner];
+    });
+  });
+  for (const std::atomic<int>& count : visits) EXPECT_EQ(count, 1);
+}
+
+TEST(Parallel, ParallelReduceIsDeterministic) {
+  // Floating point addition is not associative, so any reordering of the
+  // partial sums would change the result.
+  constexpr size_t kSize = 100000;
+  std::vector<double> values(kSize);
+  for (size_t i = 0; i < kSize; ++i) values[i] = 1.0 / (1 + i % 977);
+  const auto sum = [&](const auto& policy) {
+    return ParallelReduce(
+        policy, kSize, 0.0,
+        [&](size_t begin, size_t end) {
+          double partial = 0;
+          for (size_t i = begin; i < end; ++i) partial += values[i];
+          return partial;
+        },
+        [](double lhs, double rhs) { return lhs + rhs; });
+  };
+  const double expected = sum(SequentialExecution{/*grain_size=*/256});
+  for (size_t num_threads : {1, 2, 3, 8}) {
+    EXPECT_EQ(sum(ParallelExecution{num_threads, /*grain_size=*/256}),
+              expected);
+  }
+}
+
+TEST(Parallel, ParallelReducePreservesOrder) {
+  // String concatenation is associative but not commutative.
+  const std::string result = ParallelReduce(
+      ParallelExecution{/*num_threads=*/4, /*grain_size=*/3}, 26,
+      std::string(),
+      [](size_t begin, size_t end) {
+        std::string partial;
+        for (size_t i = begin; i < end; ++i) partial += 'a' + i;
+        return partial;
+      },
+      [](std::string lhs, std::string rhs) { return lhs + rhs; });
+  EXPECT_EQ(result, "abcdefghijklmnopqrstuvwxyz");
+}
+
+}  // namespace mana
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace mana {
+
+// Philox4x32-10, the counter-based random number generator of Salmon et al.,
+// "Parallel Random Numbers: As Easy as 1, 2, 3" (SC 2011). Each output block
+// of four 32-bit words is a pure function of a 128-bit counter and a 64-bit
+// key (the seed), so random streams can be evaluated in any order, on any
+// number of threads, with bitwise reproducible results: sample i simply uses
+// counter i, and no generator state is shared or advanced.
+class Philox4x32 {
+ public:
+  using Counter = std::array<uint32_t, 4>;
+  using Block = std::array<uint32_t, 4>;
+
+  // Construct from a 64-bit seed, used as the key.
+  explicit Philox4x32(uint64_t seed)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+  // Return the random block for `counter`.
+  Block operator()(Counter counter) const {
+    std::array<uint32_t, 2> key = key_;
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+      }
+      const uint64_t product0 = uint64_t{kMultiplier0} * counter[0];
+      const uint64_t product1 = uint64_t{kMultiplier1} * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                 static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                 static_cast<uint32_t>(product0)};
+    }
+    return counter;
+  }
+
+ private:
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  std::array<uint32_t, 2> key_;
+};
+
+// Map two 32-bit words to a double uniformly distributed in (0, 1], with 53
+// random bits.
+inline double ToUniform(uint32_t high, uint32_t low) {
+  const uint64_t bits = (uint64_t{high} << 21) ^ (low >> 11);
+  return (static_cast<double>(bits) + 1) * 0x1.0p-53;
+}
+
+// Map a random block to two independent standard normal samples, with the
+// Box-Muller transform.
+inline std::array<double, 2> ToGaussianPair(const Philox4x32::Block& block) {
+  const double radius = std::sqrt(-2 * std::log(ToUniform(block[0], block[1])));
+  const double angle = 2 * M_PI * ToUniform(block[2], block[3]);
+  return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+}  // namespace mana
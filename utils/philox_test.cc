@@ -0,0 +1,47 @@
+#include "utils/philox.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace mana {
+
+TEST(Philox, KnownAnswers) {
+  // Known-answer vectors from the Random123 distribution (kat_vectors).
+  EXPECT_EQ(Philox4x32(0)({0, 0, 0, 0}),
+            (Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                               0x9b00dbd8}));
+  EXPECT_EQ(Philox4x32(0xffffffffffffffff)(
+                {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}),
+            (Philox4x32::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                               0x6d5451fd}));
+  EXPECT_EQ(Philox4x32(0x299f31d0a4093822)(
+                {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}),
+            (Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                               0x24126ea1}));
+}
+
+TEST(Philox, GaussianMoments) {
+  constexpr uint32_t kNumPairs = 100000;
+  const Philox4x32 philox(42);
+  double sum = 0;
+  double sum_squares = 0;
+  for (uint32_t i = 0; i < kNumPairs; ++i) {
+    for (const double sample : ToGaussianPair(philox({i, 0, 0, 0}))) {
+      EXPECT_TRUE(std::isfinite(sample));
+      sum += sample;
+      sum_squares += sample * sample;
+    }
+  }
+  const double mean = sum / (2 * kNumPairs);
+  EXPECT_NEAR(mean, 0, 0.01);
+  EXPECT_NEAR(sum_squares / (2 * kNumPairs) - mean * mean, 1, 0.01);
+}
+
+TEST(Philox, UniformRange) {
+  EXPECT_EQ(ToUniform(0xffffffff, 0xffffffff), 1.0);
+  EXPECT_GT(ToUniform(0, 0), 0.0);
+}
+
+}  // namespace mana
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mana {
+
+// A fixed-capacity FIFO ring buffer. All storage is allocated at construction;
+// pushing and popping never allocate. Elements are indexed from the oldest
+// (front, index 0) to the newest (back, index size() - 1).
+template <typename T>
+class RingBuffer {
+ public:
+  // Construct with a fixed capacity, which must be nonzero.
+  explicit RingBuffer(size_t capacity);
+
+  // Return the maximum number of elements the buffer can hold.
+  size_t capacity() const;
+
+  // Return the number of elements currently held.
+  size_t size() const;
+
+  // Check whether the buffer holds no elements, or is at capacity.
+  bool empty() const;
+  bool full() const;
+
+  // Push an element at the back of the buffer. The buffer must not be full.
+  void PushBack(T value);
+
+  // Pop the element at the front (the oldest element). The buffer must not be
+  // empty.
+  void PopFront();
+
+  // Remove all elements.
+  void Clear();
+
+  // Access elements, ordered from oldest to newest.
+  T& operator[](size_t index);
+  const T& operator[](size_t index) const;
+  T& front();
+  const T& front() const;
+  T& back();
+  const T& back() const;
+
+ private:
+  // Map a logical index (0 = oldest) to an index into `storage_`.
+  size_t StorageIndex(size_t index) const;
+
+  std::vector<T> storage_;
+  // Storage index of the oldest element.
+  size_t head_ = 0;
+  // Number of elements currently held.
+  size_t size_ = 0;
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_t capacity) : storage_(capacity) {
+  assert(capacity > 0);
+}
+
+template <typename T>
+size_t RingBuffer<T>::capacity() const {
+  return storage_.size();
+}
+
+template <typename T>
+size_t RingBuffer<T>::size() const {
+  return size_;
+}
+
+template <typename T>
+bool RingBuffer<T>::empty() const {
+  return size_ == 0;
+}
+
+template <typename T>
+bool RingBuffer<T>::full() const {
+  return size_ == capacity();
+}
+
+template <typename T>
+void RingBuffer<T>::PushBack(T value) {
+  assert(!full());
+  storage_[StorageIndex(size_)] = std::move(value);
+  ++size_;
+}
+
+template <typename T>
+void RingBuffer<T>::PopFront() {
+  assert(!empty());
+  head_ = StorageIndex(1);
+  --size_;
+}
+
+template <typename T>
+void RingBuffer<T>::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+template <typename T>
+T& RingBuffer<T>::operator[](size_t index) {
+  assert(index < size_);
+  return storage_[StorageIndex(index)];
+}
+
+template <typename T>
+const T& RingBuffer<T>::operator[](size_t index) const {
+  assert(index < size_);
+  return storage_[StorageIndex(index)];
+}
+
+template <typename T>
+T& RingBuffer<T>::front() {
+  return (*this)[0];
+}
+
+template <typename T>
+const T& RingBuffer<T>::front() const {
+  return (*this)[0];
+}
+
+template <typename T>
+T& RingBuffer<T>::back() {
+  return (*this)[size_ - 1];
+}
+
+template <typename T>
+const T& RingBuffer<T>::back() const {
+  return (*this)[size_ - 1];
+}
+
+template <typename T>
+size_t RingBuffer<T>::StorageIndex(size_t index) const {
+  // Avoid a modulo: `head_ + index` never exceeds twice the capacity.
+  const size_t storage_index = head_ + index;
+  return (storage_index >= capacity()) ? (storage_index - capacity())
+                                       : storage_index;
+}
+
+}  // namespace mana